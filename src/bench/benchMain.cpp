@@ -0,0 +1,197 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#include "benchmark.h"
+
+// runs the benchmark scenarios and writes the results as json
+//
+// usage: ./bench.out [--out file] [--baseline file] [--tolerance fraction] [--scenario name] [--repeat n] [--snapshot file]
+//
+// with --baseline the exit code is 1 when the mean tick time of a scenario is more than
+// tolerance (default 0.5) slower than in the baseline, the baseline is an older --out file
+// every run also times a calibration loop (Benchmark::calibrate) and the baseline is scaled by how much
+// faster or slower that loop ran, so a baseline from another machine still roughly means something
+// --snapshot adds the scenario "snapshot", ten seconds of a match saved with Game::saveSnapshot (headless --save)
+// every scenario runs --repeat times (default 5) and the fastest run is kept, the others are noise from the machine
+
+static std::string toJson(double calibration, const std::vector<BenchResult> &results)
+{
+    std::ostringstream json;
+    json << "{\n  \"calibration_us\": " << calibration << ",\n  \"scenarios\": [\n";
+    for (int i=0; i < results.size(); i++) {
+        const BenchResult &result = results[i];
+        json << "    {\"name\": \"" << result.name << "\", \"ticks\": " << result.ticks
+             << ", \"tick_us\": " << result.microsecondsPerTick
+             << ", \"max_tick_us\": " << result.maxMicroseconds << ", \"zones\": {";
+        for (int j=0; j < result.zones.size(); j++) {
+            json << (j > 0 ? ", " : "") << "\"" << result.zones[j].name << "\": {\"us_per_tick\": " << result.zones[j].microsecondsPerTick
+                 << ", \"calls_per_tick\": " << result.zones[j].callsPerTick << "}";
+        }
+        json << "}}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+// only reads what toJson writes: the tick_us that follows the name of a scenario, -1 when it's not there
+static double baselineTickTime(const std::string &baseline, const std::string &name)
+{
+    size_t scenario = baseline.find("\"name\": \"" + name + "\"");
+    if (scenario == std::string::npos) {
+        return -1;
+    }
+    std::string key = "\"tick_us\": ";
+    size_t value = baseline.find(key, scenario);
+    if (value == std::string::npos) {
+        return -1;
+    }
+    return std::atof(baseline.c_str() + value + key.size());
+}
+
+// the calibration_us of the baseline, -1 when it's older than the calibration
+static double baselineCalibration(const std::string &baseline)
+{
+    std::string key = "\"calibration_us\": ";
+    size_t value = baseline.find(key);
+    if (value == std::string::npos) {
+        return -1;
+    }
+    return std::atof(baseline.c_str() + value + key.size());
+}
+
+int main(int argc, char *argv[])
+{
+    std::string outFile;
+    std::string baselineFile;
+    std::string onlyScenario;
+    double tolerance = 0.5; // timings on a busy machine easily move 20%
+    int repeat = 5;
+    std::string snapshotFile;
+
+    for (int i=1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return 2;
+        }
+
+        if (arg == "--out") {
+            outFile = argv[++i];
+        } else if (arg == "--baseline") {
+            baselineFile = argv[++i];
+        } else if (arg == "--tolerance") {
+            tolerance = std::atof(argv[++i]);
+        } else if (arg == "--scenario") {
+            onlyScenario = argv[++i];
+        } else if (arg == "--snapshot") {
+            snapshotFile = argv[++i];
+        } else if (arg == "--repeat") {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    struct Scenario { const char *name; BenchResult (*run)(); };
+    Scenario scenarios[] = {
+        {"empty17", Benchmark::emptyMap},
+        {"built256", Benchmark::builtMap},
+        {"wave200", Benchmark::lateWave},
+        {"stress5k", Benchmark::unitStress},
+    };
+
+    double calibration = Benchmark::calibrate();
+    for (int run=1; run < repeat; run++) {
+        calibration = std::min(calibration, Benchmark::calibrate());
+    }
+    std::cerr << "calibration: " << calibration << " us" << std::endl;
+
+    std::vector<BenchResult> results;
+    for (int i=0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if (!onlyScenario.empty() && onlyScenario != scenarios[i].name) {
+            continue;
+        }
+        BenchResult fastest = scenarios[i].run();
+        for (int run=1; run < repeat; run++) {
+            BenchResult result = scenarios[i].run();
+            if (result.microsecondsPerTick < fastest.microsecondsPerTick) {
+                fastest = result;
+            }
+        }
+        results.push_back(fastest);
+        std::cerr << results.back().name << ": " << results.back().microsecondsPerTick << " us/tick" << std::endl;
+    }
+
+    if (!snapshotFile.empty() && (onlyScenario.empty() || onlyScenario == "snapshot")) {
+        BenchResult fastest = Benchmark::fromSnapshot(snapshotFile);
+        if (fastest.ticks < 0) {
+            std::cerr << "can't load snapshot " << snapshotFile << std::endl;
+            return 2;
+        }
+        for (int run=1; run < repeat; run++) {
+            BenchResult result = Benchmark::fromSnapshot(snapshotFile);
+            if (result.microsecondsPerTick < fastest.microsecondsPerTick) {
+                fastest = result;
+            }
+        }
+        results.push_back(fastest);
+        std::cerr << fastest.name << ": " << fastest.microsecondsPerTick << " us/tick" << std::endl;
+    }
+
+    std::string json = toJson(calibration, results);
+    if (outFile.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream out(outFile);
+        out << json;
+        if (!out) {
+            std::cerr << "can't write " << outFile << std::endl;
+            return 2;
+        }
+    }
+
+    if (baselineFile.empty()) {
+        return 0;
+    }
+
+    std::ifstream baselineStream(baselineFile);
+    if (!baselineStream) {
+        std::cerr << "can't read baseline " << baselineFile << std::endl;
+        return 2;
+    }
+    std::stringstream baseline;
+    baseline << baselineStream.rdbuf();
+
+    // how much slower this machine is than the one of the baseline, 1 when the baseline has no calibration
+    double machineScale = 1;
+    double calibrationBefore = baselineCalibration(baseline.str());
+    if (calibrationBefore > 0) {
+        machineScale = calibration / calibrationBefore;
+        fprintf(stderr, "calibration: %.0f us, baseline %.0f, baseline timings scaled by %.2f\n", calibration, calibrationBefore, machineScale);
+    } else {
+        std::cerr << "the baseline has no calibration, comparing absolute timings" << std::endl;
+    }
+
+    bool hasRegressed = false;
+    for (int i=0; i < results.size(); i++) {
+        double before = baselineTickTime(baseline.str(), results[i].name) * machineScale;
+        if (before <= 0) {
+            std::cerr << results[i].name << ": not in the baseline" << std::endl;
+            continue;
+        }
+
+        double change = results[i].microsecondsPerTick / before - 1;
+        bool isRegression = change > tolerance;
+        fprintf(stderr, "%s: %.1f us/tick, baseline %.1f (%+.0f%%)%s\n", results[i].name.c_str(),
+                results[i].microsecondsPerTick, before, change * 100, isRegression ? " REGRESSION" : "");
+        hasRegressed = hasRegressed || isRegression;
+    }
+
+    return hasRegressed ? 1 : 0;
+}
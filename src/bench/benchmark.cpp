@@ -0,0 +1,189 @@
+#include <algorithm>
+
+#include "benchmark.h"
+
+void Benchmark::runTicks(Game &game, int ticks, BenchResult &result)
+{
+    profiler.reset();
+
+    int64_t total = 0;
+    int64_t slowest = 0;
+    for (int i=0; i < ticks; i++) {
+        game.input.clear();
+        int64_t start = profiler.now();
+        game.tick(); // keeps ticking after the castle fell, the scenarios always do the same amount of ticks
+        int64_t duration = profiler.now() - start;
+        total += duration;
+        slowest = std::max(slowest, duration);
+    }
+
+    result.ticks = ticks;
+    result.microsecondsPerTick = (double)total / ticks;
+    result.maxMicroseconds = slowest;
+    result.zones.clear();
+    for (int zone=0; zone < profiler.getZoneCount(); zone++) {
+        if (profiler.getZoneCalls(zone) == 0) {
+            continue;
+        }
+        result.zones.push_back({profiler.getZoneName(zone), profiler.getZoneTotal(zone) * 1000.0 / ticks, (double)profiler.getZoneCalls(zone) / ticks});
+    }
+}
+
+BenchResult Benchmark::emptyMap()
+{
+    BenchResult result;
+    result.name = "empty17";
+
+    Game game(1920, 1080, 17, 17);
+    game.jobs.start(0);
+    game.setSeed(1);
+    game.Start();
+
+    runTicks(game, 60 * 120, result); // two waves
+    return result;
+}
+
+BenchResult Benchmark::builtMap()
+{
+    BenchResult result;
+    result.name = "built256";
+
+    Game game(1920, 1080, 256, 256);
+    game.jobs.start(0);
+    game.setSeed(1);
+    game.Start();
+
+    // every tile inside the border, mixed so production and training both have work
+    TileType buildTypes[] = {TILE_FOOD, TILE_CORAL, TILE_TRAINING};
+    for (int x=1; x < game.map.rows - 1; x++) {
+        for (int y=1; y < game.map.cols - 1; y++) {
+            Vector2 coord = {(float)x, (float)y};
+            if (!isTileTypeCastle(game.map.getTileType(coord))) {
+                game.map.changeTileType(coord, buildTypes[(x + y) % 3]);
+            }
+        }
+    }
+    for (int i=0; i < game.map.tileCount(); i++) {
+        if (game.map.tileAtIndex(i).getType() == TILE_TRAINING) {
+            game.map.startTraining({(float)(i / game.map.cols), (float)(i % game.map.cols)}, 24);
+            game.scheduler.schedule(game.ticksFromNow(24), EVENT_TRAINING_DONE, i);
+        }
+    }
+
+    runTicks(game, 60 * 10, result);
+    return result;
+}
+
+BenchResult Benchmark::lateWave()
+{
+    BenchResult result;
+    result.name = "wave200";
+
+    Game game(1920, 1080, 17, 17);
+    game.jobs.start(0);
+    game.setSeed(1);
+    game.Start();
+
+    // defenders on every tile around the castle so the wave has something to fight
+    Vector2 center = game.map.getCastleCoord();
+    std::vector<Vector2> around = game.map.getSurroundingCoords(center);
+    for (int i=0; i < around.size(); i++) {
+        game.player.playerUnits.createUnit(around[i], 5, 1);
+    }
+    game.player.castleHealth = 1e9; // the wave shouldn't end the scenario early
+
+    // a full late wave (25 level 5 units with the capped stat multiplier of 2) spread over the border
+    // made here instead of by spawnWave, at wave 200 that only rolls the minimum amount
+    game.wave.skipTo(200);
+    game.scheduler.cancel(EVENT_WAVE); // only this one wave in the scenario
+    UnitInventory waveUnits(OWNER_WAVE, &game.map, &game.unitWorld, &game.textures);
+    std::vector<Vector2> borders = game.map.getBorders();
+    int waveSize = 25;
+    for (int i=0; i < waveSize; i++) {
+        waveUnits.createUnit(borders[i * borders.size() / waveSize], 5, 2);
+    }
+
+    runTicks(game, 60 * 30, result);
+    return result;
+}
+
+BenchResult Benchmark::unitStress()
+{
+    BenchResult result;
+    result.name = "stress5k";
+
+    int size = 128;
+    Game game(1920, 1080, size, size);
+    game.jobs.start(0);
+    game.setSeed(1);
+    game.Start();
+
+    Vector2 center = game.map.getCastleCoord();
+    std::vector<Vector2> around = game.map.getSurroundingCoords(center);
+    for (int i=0; i < around.size(); i++) {
+        game.player.playerUnits.createUnit(around[i], 5, 1);
+    }
+    game.player.castleHealth = 1e9;
+
+    UnitInventory waveUnits(OWNER_WAVE, &game.map, &game.unitWorld, &game.textures);
+    Random random(1, 3);
+    int placed = 0;
+    while (placed < 5000) {
+        int x = 1 + random.nextInt(size - 2);
+        int y = 1 + random.nextInt(size - 2);
+        if (game.unitWorld.occupancy.isOccupied(game.map.tileIndex(x, y)) || game.map.isTileLocked({(float)x, (float)y})) {
+            continue;
+        }
+        waveUnits.createUnit({(float)x, (float)y}, 1 + random.nextInt(5), 1);
+        placed++;
+    }
+
+    runTicks(game, 60 * 5, result);
+    return result;
+}
+
+BenchResult Benchmark::fromSnapshot(std::string fileName)
+{
+    BenchResult result;
+    result.name = "snapshot";
+    result.ticks = -1;
+
+    int rows, cols;
+    if (!Game::readSnapshotMapSize(fileName, rows, cols)) {
+        return result;
+    }
+
+    Game game(1920, 1080, cols, rows);
+    game.jobs.start(0);
+    game.Start();
+    if (!game.loadSnapshot(fileName)) {
+        return result;
+    }
+
+    runTicks(game, 60 * 10, result);
+    return result;
+}
+
+double Benchmark::calibrate()
+{
+    // a mix of branches, random memory reads and integer math like a tick, the same work on every machine
+    std::vector<uint32_t> values(1 << 16);
+    uint32_t state = 12345;
+    int64_t start = profiler.now();
+    uint64_t sum = 0;
+    for (int round=0; round < 8; round++) {
+        for (int i=0; i < values.size(); i++) {
+            state = state * 1664525 + 1013904223;
+            values[i] = state >> 8;
+        }
+        std::sort(values.begin(), values.end());
+        for (int i=0; i < values.size(); i++) {
+            sum += values[values[i] & (values.size() - 1)];
+        }
+    }
+    int64_t duration = profiler.now() - start;
+
+    volatile uint64_t keep = sum; // or the compiler drops the lookups
+    (void)keep;
+    return (double)duration;
+}
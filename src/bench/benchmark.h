@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "../game.h"
+
+struct BenchZone
+{
+    std::string name;
+    double microsecondsPerTick;
+    double callsPerTick;
+};
+
+struct BenchResult
+{
+    std::string name;
+    int ticks;
+    double microsecondsPerTick; // mean wall time of Game::tick
+    double maxMicroseconds; // slowest single tick
+    std::vector<BenchZone> zones; // every PROFILE_ZONE that ran, inclusive times
+};
+
+// the scripted scenarios of make bench, every one runs headless with a fixed seed and no worker threads
+// so the same build on the same machine does the same work every run
+class Benchmark
+{
+private:
+    static void runTicks(Game &game, int ticks, BenchResult &result);
+public:
+    static BenchResult emptyMap(); // the normal 17x17 match, nobody playing
+    static BenchResult builtMap(); // 256x256 with every tile built
+    static BenchResult lateWave(); // 25 level 5 wave units with the highest stat multiplier against level 5 defenders
+    static BenchResult unitStress(); // 5000 wave units on a 128x128 map
+    static BenchResult fromSnapshot(std::string fileName); // a saved match (Game::saveSnapshot), ticks = -1 when it can't be loaded
+    static double calibrate(); // microseconds of a fixed sort and lookup loop that doesn't touch the game, measures the machine
+};
@@ -1,61 +1,65 @@
+#include <ctime>
+#include <cmath>
+#include <algorithm>
+#include <random>
+
 #include "game.h"
 
+// food cost and training time in seconds of the unit levels 1 to 5
+static const int trainingFoodCost[] = {10, 20, 40, 80, 160};
+static const int trainingTime[] = {10, 13, 16, 20, 24};
+static const int trainingKeys[] = {KEY_ONE, KEY_TWO, KEY_THREE, KEY_FOUR, KEY_FIVE};
+
 Game::Game(int screenWidth, int screenHeight, int columnCount, int rowCount)
 {
     // generate map using mapSize
     Vector2 startingPosition = {screenWidth /4, screenHeight / 2}; // map generation has to give starting position, which is base position 
 
-    tileTextures = {
-        {"locked", LoadTexture("sprites/resources/BlankTile.png")},
-        {"sea", LoadTexture("sprites/resources/BlankTile.png")},
-        {"food", LoadTexture("sprites/resources/AlgenTile.png")},
-        {"coral", LoadTexture("sprites/resources/CoralTile.png")},
-        {"training", LoadTexture("sprites/buildings/TrainingTile.png")},
-        {"castleV1", LoadTexture("sprites/castle/CastleTileLVL1.png")},
-        {"castleV2", LoadTexture("sprites/castle/CastleTileLVL2.png")},
-        {"castleV3", LoadTexture("sprites/castle/CastleTileLVL3.png")},
-        {"castleV4", LoadTexture("sprites/castle/CastleTileLVL4.png")},
-        {"castleV5", LoadTexture("sprites/castle/CastleTileLVL5.png")}
-    };
-
-    unitTextures = {
-        {"warrior1LVL1", LoadTexture("sprites/units/Battlefish.png")},
-        {"warrior2LVL1", LoadTexture("sprites/units/BattlefishRed.png")},
-
-        {"warrior1LVL2", LoadTexture("sprites/units/BattleHorse.png")},
-        {"warrior2LVL2", LoadTexture("sprites/units/BattleHorseRed.png")},
-
-        {"warrior1LVL3", LoadTexture("sprites/units/Angler.png")},
-        {"warrior2LVL3", LoadTexture("sprites/units/AnglerRed.png")},
-
-        {"warrior1LVL4", LoadTexture("sprites/units/BattleHorse.png")},
-        {"warrior2LVL4", LoadTexture("sprites/units/BattleHorseRed.png")},
-
-        {"warrior1LVL5", LoadTexture("sprites/units/SharkRegular.png")},
-        {"warrior2LVL5", LoadTexture("sprites/units/SharkRed.png")}
-    };
-    
-    castleTypes = {"castleV1", "castleV2", "castleV3", "castleV4", "castleV5"};
+    // every sprite of a match lives in the registry, tiles and units only keep a handle
+    // decoded on worker threads, the loading screen keeps drawing while they are uploaded a few per frame
+    AssetLoader loader;
+    if (!loader.queueManifest(BAKED_SPRITE_MANIFEST)) { // not baked (make bake), use the full size sources
+        for (int i=0; i < spriteSourceCount; i++) {
+            loader.queue(spriteSources[i].name, spriteSources[i].file);
+        }
+    }
+    loader.start(std::min((int)std::thread::hardware_concurrency(), 4));
+    while (!loader.uploadSome(&textures, 0.004)) {
+        progressLoadingScreen(100, screenWidth, screenHeight, loader.getProgress());
+    }
 
-    tileHighLiteWhite = LoadTexture("sprites/UI-elements/hexHighlight.png");
-    tileHighLiteRed = LoadTexture("sprites/UI-elements/hexRedHighlight.png");
+    // shared with the map and the overlay through the registry
+    tileHighLiteWhite = textures.get(textures.load("hexHighlight", "sprites/UI-elements/hexHighlight.png"));
+    tileHighLiteRed = textures.get(textures.load("hexRedHighlight", "sprites/UI-elements/hexRedHighlight.png"));
     
 
-    overlay = Overlay(screenWidth, screenHeight, tileTextures);
-    map = Map(rowCount, columnCount, tileTextures);
-    player = Player(startingPosition, screenWidth, screenHeight, &map, &tileHighLiteWhite, unitTextures);
-    wave = Wave2(&map, &player.camera, &tileHighLiteWhite, unitTextures);
-
+    overlay = Overlay(screenWidth, screenHeight, &textures);
+    map = Map(rowCount, columnCount, &textures);
+    player = Player(startingPosition, screenWidth, screenHeight, &map, &tileHighLiteWhite, &textures, &unitWorld);
+    pathfinder = Pathfinder(&map, &unitWorld.occupancy);
+    castleField = FlowField(&map);
+    jobs.start(std::min((int)std::thread::hardware_concurrency() - 1, 7));
+    unitWorld = UnitWorld(&map, &player.camera, &textures, &tileHighLiteWhite, &pathfinder, &castleField, &jobs, &unitRandom);
+    wave = Wave2(&map, &player.camera, &tileHighLiteWhite, &textures, &unitWorld, &waveRandom);
+
+    // a different match every time unless setSeed is called, the clock is mixed in for platforms where random_device is fixed
+    std::random_device entropy;
+    seed = (((uint64_t)entropy() << 32) | entropy()) ^ (uint64_t)time(NULL);
     gameTime = 0;
+    tickCount = 0;
     waveCount = 0;
     score = 0;
 
+    setTickRate(60);
+    accumulator = 0;
+    maxTicksPerFrame = 10; // a hitch longer than this many ticks is dropped instead of simulated
+
     isCastleMenu = false;
     isTrainingMenu = false;
     
-    int foodTileCost = player.getTileCost("food");
-    int coralTileCost = player.getTileCost("coral");
-    int trainingTileCost = player.getTileCost("training");
+    int foodTileCost = player.getTileCost(TILE_FOOD);
+    int coralTileCost = player.getTileCost(TILE_CORAL);
+    int trainingTileCost = player.getTileCost(TILE_TRAINING);
     overlay.setTileTypeCosts(foodTileCost, coralTileCost, trainingTileCost);
 
     song = LoadMusicStream("music/GuitarSong.mp3");
@@ -63,30 +67,17 @@ Game::Game(int screenWidth, int screenHeight, int columnCount, int rowCount)
 
 Game::~Game()
 {
-    std::vector<std::string> unloadTileTextures = {"locked", "sea", "food", "coral", "training", "castleV1", "castleV2", "castleV3", "castleV4", "castleV5"};
-
-    for (int i=0; i < unloadTileTextures.size(); i++) {
-        UnloadTexture(tileTextures[unloadTileTextures.at(i)]);
-    }
-    
-    std::vector<std::string> unloadUnitTextures = {"warrior1LVL1", "warrior2LVL1"};
-
-    for (int i=0; i < unloadUnitTextures.size(); i++) {
-        UnloadTexture(unitTextures[unloadUnitTextures.at(i)]);
-    }
-
-    UnloadTexture(tileHighLiteWhite);
-    UnloadTexture(tileHighLiteRed);
+    recorder.close(tickCount);
+    textures.unloadAll(); // the files stay in the TextureCache for the next match
 }
 
 void Game::Update(double dt)
 {
-    bool isMouseOnOverlay = overlay.isMouseOnOverlay(); // check if mouse is on overlay so it can be used for player aswell
-
     for (int i=0; i < surroundingCenter.size(); i++) {
-        if (surroundingCenter.at(i)->isUnitOnTile) {
-            if (surroundingCenter.at(i)->unitOnTile->owner != "player") {
-                    player.castleHealth -= surroundingCenter.at(i)->unitOnTile->attackDamage * dt;
+        if (unitWorld.occupancy.isOccupiedBy(surroundingCenter.at(i), OWNER_WAVE)) {
+            int unit = unitWorld.indexOf(unitWorld.occupancy.unitAt(surroundingCenter.at(i)));
+            if (unit != -1) {
+                    player.castleHealth -= unitWorld.attackDamage[unit] * dt;
             }
         }
     }
@@ -95,147 +86,214 @@ void Game::Update(double dt)
         gameRunning = false;
     }
 
-    if(IsMouseButtonPressed(0)) { // makes build mode and overlay selction work
-        
-        Vector2 worldMousePos = GetScreenToWorld2D(GetMousePosition(), player.camera);
-        Vector2 coord = map.worldPosToGridPos(worldMousePos);
+    // the player's clicks and keys become commands, a replay hands back the recorded ones instead
+    tickCommands.clear();
+    if (replay.isPlaying()) {
+        replay.commandsAt(tickCount, tickCommands);
+        for (int i=0; i < tickCommands.size(); i++) {
+            if (tickCommands[i].type != COMMAND_UNIT_ORDER) {
+                execute(tickCommands[i]);
+            }
+        }
+    } else {
+        handleInput();
+    }
+
+    if(noMoneyMsgCountDown > 0.0) {
+        noMoneyMsgCountDown -= dt;
+    }
+
+    runEvents();
+
+    overlay.updateCooldown(dt);
+    player.Update(dt, overlay.selectedBuildTile, &input); // update all the objects that are in player
+
+    // unit orders act on the units after their own update, a new move starts on the next tick
+    for (int i=0; i < tickCommands.size(); i++) {
+        if (tickCommands[i].type == COMMAND_UNIT_ORDER) {
+            execute(tickCommands[i]);
+        }
+    }
+
+    wave.Update(dt);
+
+    waveCount = wave.waveCount;
+}
+
+void Game::handleInput()
+{
+    bool isMouseOnOverlay = overlay.isMouseOnOverlay(input.getMousePosition()); // check if mouse is on overlay so it can be used for player aswell
+    Vector2 worldMousePos = GetScreenToWorld2D(input.getMousePosition(), player.camera);
+    Vector2 coord = map.worldPosToGridPos(worldMousePos);
+
+    if(input.isMouseButtonPressed(0)) { // makes build mode and overlay selction work
         if(overlay.isBuildMode) {
             if(isMouseOnOverlay) {
-                int buildTile = overlay.mouseOnBuildTile();
+                int buildTile = overlay.mouseOnBuildTile(input.getMousePosition());
                 if(buildTile != -1) {
                     overlay.selectBuildTile(buildTile);
                 }
                 // do stuff with overlay
             } else if (!isCastleMenu && !isTrainingMenu) {
-                std::string buildTileName = overlay.getBuildTileName();
-                if(buildTileName != "" && map.isSurrounded(coord) && map.isTileAvailable(coord, buildTileName)) {
-                    bool isBought = player.buyTile(buildTileName);
-                    if(isBought) {
-                        map.changeTileType(coord, buildTileName);
-                        int foodTileCost = player.getTileCost("food");
-                        int coralTileCost = player.getTileCost("coral");
-                        int trainingTileCost = player.getTileCost("training");
-                        overlay.setTileTypeCosts(foodTileCost, coralTileCost, trainingTileCost);
-                    } else {
+                TileType buildTileType = overlay.getBuildTileType();
+                if(buildTileType != TILE_NONE && map.isSurrounded(coord) && map.isTileAvailable(coord, buildTileType)) {
+                    if(!execute({COMMAND_BUILD_TILE, (int)coord.x, (int)coord.y, buildTileType})) {
                         noMoneyMsgCountDown = 1.0;
-                        // DrawTextEx(GetFontDefault(), "NOT ENOUGH MONEY", (Vector2){GetScreenWidth() / 2, GetScreenHeight() / 2}, 50, 10, DARKGRAY);
-                        // not enough money
                     }
                 }
             }
         }
 
-        bool isMouseOnCastle = (std::find(castleTypes.begin(), castleTypes.end(), map.getTileType(coord)) != castleTypes.end());
+        bool isMouseOnCastle = isTileTypeCastle(map.getTileType(coord));
         if(isMouseOnCastle) {
             isCastleMenu = true;
         }
 
-        if(map.getTileType(coord) == "training" && overlay.getBuildTileName() == "") {
-            overlay.trainingCooldown = map.getTile(coord)->trainingCooldown;
+        if(map.getTileType(coord) == TILE_TRAINING && overlay.getBuildTileType() == TILE_NONE) {
+            overlay.trainingCooldown = map.getTile(coord)->isTraining ? map.getTile(coord)->trainingDoneTime - gameTime : 0;
             isTrainingMenu = true;
             trainingTileLocation = coord;
             selectedTrainingTile = map.getTile(coord);
         }
-
     }
 
     if(isCastleMenu) {
-        if(IsKeyPressed(KEY_C)) {
+        if(input.isKeyPressed(KEY_C)) {
             isCastleMenu = false;
-        } else if (IsKeyPressed(KEY_L)) {
-            bool isBought = player.buyCastleUpgrade();
-            if(isBought) {
+        } else if (input.isKeyPressed(KEY_L)) {
+            if(execute({COMMAND_UPGRADE_CASTLE, 0, 0, 0})) {
                 isCastleMenu = false;
-                int castleLvl = player.getCastleLvl();
-                map.changeTileType({8, 8}, castleTypes.at(castleLvl - 1));
             } else {
                 noMoneyMsgCountDown = 1.0;
             }
         }
     } else if (isTrainingMenu) {
         // create unit
-        Vector2 worldMousePos = GetScreenToWorld2D(GetMousePosition(), player.camera);
-        Vector2 coord = map.worldPosToGridPos(worldMousePos);
-
-        if (!selectedTrainingTile->isTraining && !map.getTile(coord)->isUnitOnTile) {
-            if (IsKeyPressed(KEY_ONE)) {
-                if(player.getFoodAmount() >= 10) {
-                    player.addFoodAmount(-10);
-                    selectedTrainingTile->trainingCooldown = 10;
-                    selectedTrainingTile->isTraining = true;
-                    player.playerUnits.createUnit(trainingTileLocation, &player.camera, 1, 1);
-                    isTrainingMenu = false;
-                } else {
-                    noMoneyMsgCountDown = 1.0;
-                }
-            } else if (IsKeyPressed(KEY_TWO) && player.getCastleLvl() > 1) {
-                if(player.getFoodAmount() >= 20) {
-                    player.addFoodAmount(-20);
-                    selectedTrainingTile->trainingCooldown = 13;
-                    selectedTrainingTile->isTraining = true;
-                    player.playerUnits.createUnit(trainingTileLocation, &player.camera, 2, 1);
-                    isTrainingMenu = false;
-                } else {
-                    noMoneyMsgCountDown = 1.0;
+        int level = 0;
+        if (!selectedTrainingTile->isTraining && !unitWorld.occupancy.isOccupied(map.getTileIndex(trainingTileLocation))) {
+            for (int i=0; i < 5 && level == 0; i++) {
+                if (input.isKeyPressed(trainingKeys[i]) && player.getCastleLvl() > i) {
+                    level = i + 1;
                 }
-            } else if (IsKeyPressed(KEY_THREE) && player.getCastleLvl() > 2) {
-                if(player.getFoodAmount() >= 40) {
-                    player.addFoodAmount(-40);
-                    selectedTrainingTile->trainingCooldown = 16;
-                    selectedTrainingTile->isTraining = true;
-                    player.playerUnits.createUnit(trainingTileLocation, &player.camera, 3, 1);
-                    isTrainingMenu = false;
-                } else {
-                    noMoneyMsgCountDown = 1.0;
-                }
-            } else if (IsKeyPressed(KEY_FOUR) && player.getCastleLvl() > 3) {
-                if(player.getFoodAmount() >= 80) {
-                    player.addFoodAmount(-80);
-                    selectedTrainingTile->trainingCooldown = 20;
-                    selectedTrainingTile->isTraining = true;
-                    player.playerUnits.createUnit(trainingTileLocation, &player.camera, 4, 1);
-                    isTrainingMenu = false;
-                } else {
-                    noMoneyMsgCountDown = 1.0;
-                }
-            } else if (IsKeyPressed(KEY_FIVE) && player.getCastleLvl() > 4) {
-                if(player.getFoodAmount() >= 160) {
-                    player.addFoodAmount(-160);
-                    selectedTrainingTile->trainingCooldown = 24;
-                    selectedTrainingTile->isTraining = true;
-                    player.playerUnits.createUnit(trainingTileLocation, &player.camera, 5, 1);
-                    isTrainingMenu = false;
-                } else {
-                    noMoneyMsgCountDown = 1.0;
-                }
-            } else if (IsKeyPressed(KEY_C)) {
-                isTrainingMenu = false;
             }
-        } else {
-            if (IsKeyPressed(KEY_C)) {
+        }
+
+        if (level > 0) {
+            if(execute({COMMAND_TRAIN_UNIT, (int)trainingTileLocation.x, (int)trainingTileLocation.y, level})) {
                 isTrainingMenu = false;
+            } else {
+                noMoneyMsgCountDown = 1.0;
             }
+        } else if (input.isKeyPressed(KEY_C)) {
+            isTrainingMenu = false;
         }
     }
 
-    if(noMoneyMsgCountDown > 0.0) {
-        noMoneyMsgCountDown -= dt;
+    // the units see the click when nothing is being build, it's applied after they moved this tick
+    if (input.isMouseButtonPressed(0) && overlay.getBuildTileType() == TILE_NONE) {
+        tickCommands.push_back({COMMAND_UNIT_ORDER, (int)coord.x, (int)coord.y, 0});
     }
+}
 
-    overlay.updateCooldown(dt);
-    bool dontMove = false;
-    if(overlay.getBuildTileName() == "") {
-        dontMove = true;
-    } 
-    player.Update(dt, overlay.selectedBuildTile, dontMove); // update all the objects that are in player
-    wave.Update(dt);
-    map.Update(dt);
+bool Game::execute(Command command)
+{
+    recorder.record(tickCount, command);
+
+    Vector2 coord = {(float)command.x, (float)command.y};
+    if (command.type == COMMAND_BUILD_TILE) {
+        return buildTile(coord, command.value);
+    } else if (command.type == COMMAND_TRAIN_UNIT) {
+        return trainUnit(coord, command.value);
+    } else if (command.type == COMMAND_UPGRADE_CASTLE) {
+        return upgradeCastle();
+    } else if (command.type == COMMAND_UNIT_ORDER) {
+        unitWorld.orderAt(command.x, command.y);
+        return true;
+    }
+    return false;
+}
+
+bool Game::buildTile(Vector2 coord, int type)
+{
+    // checked again here so a damaged replay can't build what the ui wouldn't allow
+    if (type < 0 || type >= TILE_TYPE_COUNT || !tileTypeInfo[type].buildable) {
+        return false;
+    }
+    TileType buildTileType = (TileType)type;
+    if (!map.isSurrounded(coord) || !map.isTileAvailable(coord, buildTileType)) {
+        return false;
+    }
+
+    if (!player.buyTile(buildTileType)) {
+        return false;
+    }
+
+    map.changeTileType(coord, buildTileType);
+    int foodTileCost = player.getTileCost(TILE_FOOD);
+    int coralTileCost = player.getTileCost(TILE_CORAL);
+    int trainingTileCost = player.getTileCost(TILE_TRAINING);
+    overlay.setTileTypeCosts(foodTileCost, coralTileCost, trainingTileCost);
+    return true;
+}
+
+bool Game::trainUnit(Vector2 coord, int level)
+{
+    if (level < 1 || level > 5 || level > player.getCastleLvl() || map.getTileType(coord) != TILE_TRAINING) {
+        return false;
+    }
+
+    Tile *trainingTile = map.getTile(coord);
+    if (trainingTile->isTraining || player.getFoodAmount() < trainingFoodCost[level - 1]) {
+        return false;
+    }
+    if (unitWorld.occupancy.isOccupied(map.getTileIndex(coord))) {
+        return false; // the new unit stands on the training tile
+    }
+
+    if (!player.playerUnits.createUnit(coord, level, 1)) {
+        return false;
+    }
+    player.addFoodAmount(-trainingFoodCost[level - 1]);
+    map.startTraining(coord, gameTime + trainingTime[level - 1]);
+    scheduler.schedule(ticksFromNow(trainingTime[level - 1]), EVENT_TRAINING_DONE, map.getTileIndex(coord));
+    return true;
+}
+
+int64_t Game::ticksFromNow(double seconds)
+{
+    return tickCount + std::max(1L, std::lround(seconds / tickLength));
+}
 
-    MusicPlayer(); // play the song 
+void Game::runEvents()
+{
+    Event event;
+    while (scheduler.popDue(tickCount, event)) {
+        if (event.type == EVENT_PRODUCTION) {
+            player.produce();
+            scheduler.schedule(ticksFromNow(player.getProductionSpeed()), EVENT_PRODUCTION); // a castle upgrade shortens the next interval
+        } else if (event.type == EVENT_WAVE) {
+            wave.nextWave(gameTime); // sets nextWaveTime before calcWaveLevel shortens the cooldown for the wave after
+            scheduler.schedule(ticksFromNow(wave.nextWaveTime - gameTime), EVENT_WAVE);
+        } else if (event.type == EVENT_TRAINING_DONE) {
+            map.finishTraining(event.target);
+        }
+    }
+}
+
+bool Game::upgradeCastle()
+{
+    if (!player.buyCastleUpgrade()) {
+        return false;
+    }
+
+    int castleLvl = player.getCastleLvl();
+    map.changeTileType(map.getCastleCoord(), castleTileType(castleLvl));
+    return true;
 }
 
 void Game::MusicPlayer() 
 {
+    PROFILE_ZONE("Game::MusicPlayer");
     if (!IsMusicStreamPlaying(song)) { // start song if not already playing
         PlayMusicStream(song);
     } else {
@@ -243,22 +301,23 @@ void Game::MusicPlayer()
     }
 }
 
-void Game::Render()
+void Game::Render(double alpha)
 {
+    PROFILE_ZONE("Game::Render");
     BeginDrawing();
         ClearBackground(BLACK);
-        Vector2 worldMousePos = GetScreenToWorld2D(GetMousePosition(), player.camera); // dit voor screen pos naar world pos
+        Vector2 worldMousePos = GetScreenToWorld2D(input.getMousePosition(), player.camera); // dit voor screen pos naar world pos
         Vector2 coord = map.worldPosToGridPos(worldMousePos);
         BeginMode2D(player.camera);
-            map.draw(); // draw the tiles
+            map.draw(player.camera); // draw the tiles
 
-            player.Render(); // draw player units
-            wave.Render();
+            player.Render(alpha); // draw player units
+            wave.Render(alpha);
 
-            if(!overlay.isMouseOnOverlay() && overlay.isBuildMode && !isCastleMenu) {
-                std::string buildTileName = overlay.getBuildTileName();
-                if(buildTileName != "") {
-                    map.drawGhostTile(coord, buildTileName, map.isSurrounded(coord));
+            if(!overlay.isMouseOnOverlay(input.getMousePosition()) && overlay.isBuildMode && !isCastleMenu) {
+                TileType buildTileType = overlay.getBuildTileType();
+                if(buildTileType != TILE_NONE) {
+                    map.drawGhostTile(coord, buildTileType, map.isSurrounded(coord));
                 }
             }
 
@@ -266,12 +325,12 @@ void Game::Render()
         
         if(isCastleMenu) {
             overlay.drawCastleMenu(player.getCastleLvl());
-        } else if (isTrainingMenu && overlay.getBuildTileName() == "") {
+        } else if (isTrainingMenu && overlay.getBuildTileType() == TILE_NONE) {
             overlay.drawTrainingMenu(player.getCastleLvl());
         }
 
             std::cout << isTrainingMenu ? "Training" : "Not Training";
-            std::cout << "name: " << overlay.getBuildTileName() << std::endl;
+            std::cout << "name: " << tileTypeName(overlay.getBuildTileType()) << std::endl;
 
         if(noMoneyMsgCountDown > 0) {
             Vector2 textDimentions = MeasureTextEx(GetFontDefault(), "NOT ENOUGH MONEY", 50, 10);
@@ -285,40 +344,215 @@ void Game::Render()
         int food = player.getFoodAmount();
         int coral = player.getCoralAmount();
         int time = int(gameTime);
-        int timeUntilNextWave = round(wave.timeUntilNextWave);
+        int timeUntilNextWave = round(wave.nextWaveTime - gameTime);
         overlay.drawInventory(food, coral, score, time, wave.waveCount, timeUntilNextWave);
 
         overlay.drawBuildMode();
+
+#ifdef PROFILING
+        if (overlay.isProfilerShown) {
+            overlay.drawProfiler(&profiler);
+        }
+#endif
     EndDrawing();
 }
 
 void Game::Start() {
     gameRunning = true;
-    Vector2 center = {int(map.cols/2), int(map.rows/2)};
+    if (!recordFileName.empty()) {
+        recorder.open(recordFileName, {seed, 1.0 / tickLength, map.rows, map.cols});
+    }
+    waveRandom.seed(seed, 1);
+    unitRandom.seed(seed, 2);
+
+    Vector2 center = map.getCastleCoord();
     mapCenter = map.getTile(center);
     std::vector<Vector2> surroundingCoords = map.getSurroundingCoords(center);
 
     for (int i=0; i < surroundingCoords.size(); i++) {
-        surroundingCenter.push_back(map.getTile(surroundingCoords.at(i)));
+        surroundingCenter.push_back(map.getTileIndex(surroundingCoords.at(i)));
     }
 
+    castleField.setGoal(map.tileIndex(center.x, center.y));
     player.Start(center);
     wave.Start();
+
+    scheduler.clear();
+    scheduler.schedule(ticksFromNow(player.getProductionSpeed()), EVENT_PRODUCTION);
+    scheduler.schedule(ticksFromNow(wave.nextWaveTime - gameTime), EVENT_WAVE);
 }
 
-void Game::run() // start the game loop
+void Game::setSeed(uint64_t newSeed)
+{
+    seed = newSeed;
+}
+
+uint64_t Game::getSeed()
+{
+    return seed;
+}
+
+void Game::recordTo(std::string fileName)
+{
+    recordFileName = fileName;
+}
+
+bool Game::playReplay(std::string fileName)
+{
+    if (!replay.open(fileName)) {
+        return false;
+    }
+
+    ReplayHeader header = replay.getHeader();
+    if (header.rows != map.rows || header.cols != map.cols || header.tickRate <= 0) {
+        replay = ReplayPlayer();
+        return false;
+    }
+
+    setSeed(header.seed);
+    setTickRate(header.tickRate);
+    return true;
+}
+
+bool Game::saveSnapshot(std::string fileName)
+{
+    SnapshotWriter writer;
+    writer.write(map.rows);
+    writer.write(map.cols);
+    writer.write(seed);
+    writer.write(tickLength);
+    writer.write(tickCount);
+    writer.write(gameTime);
+    writer.write(score);
+    writer.write(waveRandom);
+    writer.write(unitRandom);
+
+    map.saveState(writer);
+    player.saveState(writer);
+    wave.saveState(writer);
+    unitWorld.saveState(writer);
+    scheduler.saveState(writer);
+    return writer.saveTo(fileName);
+}
+
+bool Game::loadSnapshot(std::string fileName)
+{
+    SnapshotReader reader;
+    if (!reader.loadFrom(fileName)) {
+        return false;
+    }
+
+    int rows, cols;
+    reader.read(rows);
+    reader.read(cols);
+    if (reader.hasFailed() || rows != map.rows || cols != map.cols) {
+        return false; // nothing changed yet
+    }
+    recorder.close(tickCount); // a replay can't go on from here, the commands would be played on the wrong match
+
+    reader.read(seed);
+    reader.read(tickLength);
+    reader.read(tickCount);
+    reader.read(gameTime);
+    reader.read(score);
+    reader.read(waveRandom);
+    reader.read(unitRandom);
+
+    bool isLoaded = !reader.hasFailed() && map.loadState(reader) && player.loadState(reader) && wave.loadState(reader) && unitWorld.loadState(reader) && scheduler.loadState(reader);
+    if (!isLoaded) {
+        gameRunning = false; // part of the match is from the snapshot and part isn't, it can't be played on
+        return false;
+    }
+
+    // everything that is worked out from the state is made again
+    waveCount = wave.waveCount;
+    accumulator = 0;
+    gameRunning = player.castleHealth > 0;
+    castleField.setGoal(castleField.getGoal());
+    pathfinder.clearCache();
+    overlay.setTileTypeCosts(player.getTileCost(TILE_FOOD), player.getTileCost(TILE_CORAL), player.getTileCost(TILE_TRAINING));
+    return true;
+}
+
+bool Game::readSnapshotMapSize(std::string fileName, int &rows, int &cols)
 {
-    double dt;
+    SnapshotReader reader;
+    return reader.loadFrom(fileName) && reader.read(rows) && reader.read(cols);
+}
+
+void Game::setTickRate(double ticksPerSecond)
+{
+    tickLength = 1.0 / ticksPerSecond;
+}
+
+double Game::getTickLength()
+{
+    return tickLength;
+}
+
+void Game::tick()
+{
+    PROFILE_ZONE("Game::tick");
+    pathfinder.beginTick();
+    Update(tickLength);
+    input.clearPressed();
+
+    tickCount++;
+    gameTime = tickCount * tickLength; // no accumulated rounding, same clock on every machine
 
+    if (replay.isPlaying() && replay.isFinished(tickCount)) {
+        gameRunning = false; // the recorded match was quit here
+    }
+}
+
+bool Game::isRunning()
+{
+    return gameRunning;
+}
+
+void Game::run() // start the game loop
+{
     Start();
     
     while (gameRunning && !WindowShouldClose())
     {
-        dt = GetFrameTime();
-        Update(dt);
-        Render();
+        input.poll();
+
+        // quick save and load, the snapshot holds the whole match
+        bool isSavePressed = input.takeKeyPressed(KEY_F5);
+        bool isLoadPressed = input.takeKeyPressed(KEY_F9);
+        if (isSavePressed) {
+            saveSnapshot("quicksave.snapshot");
+        } else if (isLoadPressed && !replay.isPlaying()) {
+            loadSnapshot("quicksave.snapshot"); // a missing file changes nothing, a damaged one ends the match
+        }
+
+#ifdef PROFILING
+        if (input.takeKeyPressed(KEY_F3)) {
+            overlay.isProfilerShown = !overlay.isProfilerShown;
+        }
+        if (input.takeKeyPressed(KEY_F4)) {
+            profiler.writeCsv("profile.csv");
+            profiler.writeChromeTrace("profile.json");
+        }
+#endif
+
+        // the simulation always moves in steps of tickLength, slow frames run several ticks to catch up
+        accumulator += GetFrameTime();
+        if (accumulator > maxTicksPerFrame * tickLength) {
+            accumulator = maxTicksPerFrame * tickLength;
+        }
+
+        while (gameRunning && accumulator >= tickLength) {
+            tick();
+            accumulator -= tickLength;
+        }
+
+        MusicPlayer(); // play the song 
+        Render(accumulator / tickLength); // how far we are into the next tick, used to smooth the unit movement
+
+        PROFILE_FRAME();
 
-        gameTime += dt;
         // If quit go to main menu
         // When esc press open menu for settings, save, load, continue and exit
     }
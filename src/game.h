@@ -7,12 +7,27 @@
 #include "player/player.h"
 #include "player/overlay.h"
 #include "map/map.h"
-#include "units/unit.h"
+#include "units/unitWorld.h"
+#include "pathfinding/pathfinder.h"
+#include "pathfinding/flowField.h"
+#include "jobs/jobSystem.h"
+#include "random/random.h"
+#include "replay/replay.h"
+#include "profiler/profiler.h"
+#include "save/snapshot.h"
+#include "scheduler/scheduler.h"
 #include "waves/wave.h"
+#include "input/input.h"
+#include "textures/textureRegistry.h"
+#include "textures/spriteList.h"
+#include "textures/assetLoader.h"
+#include "ui/loadingScreen.h"
 #include "gameOver.h"
 
 class Game
 {
+    friend class Benchmark; // sets up the scenarios in src/bench
+
 private:
     Player player;
     Overlay overlay;
@@ -21,15 +36,29 @@ private:
     Wave2 wave;
     GameOver gameOverScreen;
 
-    std::vector<std::string> castleTypes;
     bool isCastleMenu;
     bool isTrainingMenu;
     bool gameRunning;
     
     Tile *selectedTrainingTile;
 
-    std::map<std::string, Texture2D> tileTextures;
-    std::map<std::string, Texture2D> unitTextures;
+    TextureRegistry textures;
+    Pathfinder pathfinder; // shared by all units, its query budget is reset every tick
+    FlowField castleField; // distance of every tile to the castle, for the wave units
+    UnitWorld unitWorld; // every unit of the match, player and wave
+
+    // one generator per subsystem, so a change in how often one of them draws doesn't shift the others
+    uint64_t seed;
+    Random waveRandom;
+    Random unitRandom;
+
+    ReplayRecorder recorder; // writes every executed command when recordTo was called
+    ReplayPlayer replay; // when playing, the commands come from here instead of the input
+    std::string recordFileName;
+    std::vector<Command> tickCommands; // the commands of the current tick, unit orders wait in here until after the units moved
+
+    Scheduler scheduler; // production, waves and trainings on the tick they are due
+
     Texture2D tileHighLiteWhite;
     Texture2D tileHighLiteRed;
 
@@ -37,18 +66,47 @@ private:
 
     double noMoneyMsgCountDown = 0;
 
+    double tickLength; // seconds of game time per simulation tick
+    double accumulator; // real time that has not been simulated yet
+    int maxTicksPerFrame;
+
     void Update(double dt);
-    void Render();
-    void Start();
+    void handleInput(); // clicks and keys to ui changes and commands
+    bool execute(Command command); // false when it couldn't be done (not enough money, not allowed)
+    bool buildTile(Vector2 coord, int type);
+    bool trainUnit(Vector2 coord, int level);
+    bool upgradeCastle();
+    int64_t ticksFromNow(double seconds); // the tick an event in that many seconds falls on, at least the next one
+    void runEvents(); // everything the scheduler has for this tick
+    void Render(double alpha);
     void MusicPlayer();
 
 public:
     Tile *mapCenter;
-    std::vector<Tile*> surroundingCenter;
+    std::vector<int> surroundingCenter; // tile indices around the castle, wave units on them damage it
     double gameTime;
+    long tickCount;
     int waveCount;
     int score;
 
+    Input input; // filled by run() from raylib, or injected by the headless runner before every step
+    JobSystem jobs; // worker threads for the unit passes, the results don't depend on how many there are
+
+    void Start();
+    void setSeed(uint64_t newSeed); // before Start(), the same seed and input plays the same match
+    uint64_t getSeed();
+    void recordTo(std::string fileName); // before Start(), the match is written there as it's played
+    bool playReplay(std::string fileName); // before Start(), false when the file can't be read or is for another map size
+    void setTickRate(double ticksPerSecond);
+
+    // the whole match (clock, random generators, map, player, wave and units) in one file, loadSnapshot goes after Start()
+    // the game has to be made with the same map size, when loading fails halfway the match is ended (isRunning() is false)
+    bool saveSnapshot(std::string fileName);
+    bool loadSnapshot(std::string fileName);
+    static bool readSnapshotMapSize(std::string fileName, int &rows, int &cols);
+    double getTickLength();
+    void tick(); // advance the simulation by exactly one fixed tick, no window needed
+    bool isRunning();
     void run();
 
     Game(int screenWidth, int screenHeight, int columnCount, int rowCount);
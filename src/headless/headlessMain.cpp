@@ -0,0 +1,157 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+
+#include "../game.h"
+
+// runs matches without a window, gpu or audio device
+// the raylib calls that are left in the game code are satisfied by raylibStub.cpp
+//
+// usage: ./headless.out [--matches n] [--tick-rate hz] [--max-time seconds] [--size n] [--threads n] [--seed n] [--record file] [--replay file] [--profile name]
+//                      [--load file] [--save file]
+//
+// --record writes match n to file.n (just file when there is one match), --replay plays one recorded match
+// with the seed, tick rate and map size it was recorded with
+// --load starts every match from a snapshot (map size from the snapshot), --save writes a snapshot at the end
+// of match n to file.n (just file when there is one match)
+// --profile writes name.csv and name.json (chrome trace) at the end, needs make PROFILE=1
+// the profiler keeps a ring of frames, so the csv only has a row for each of the last Profiler::frameHistory - 1 ticks
+// and the trace only the last Profiler::maxEvents zone runs
+
+int main(int argc, char *argv[])
+{
+    int matches = 1;
+    double tickRate = 60;
+    double maxTime = 60 * 60;
+    int mapSize = 17;
+    int threads = -1; // -1 keeps the game's default
+    bool hasSeed = false;
+    uint64_t seed = 0; // match n plays with seed + n, drawn once per run when --seed isn't given
+    std::string recordFile;
+    std::string replayFile;
+    std::string profileName;
+    std::string loadFile;
+    std::string saveFile;
+
+    for (int i=1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return 1;
+        }
+
+        if (arg == "--matches") {
+            matches = std::atoi(argv[++i]);
+        } else if (arg == "--tick-rate") {
+            tickRate = std::atof(argv[++i]);
+        } else if (arg == "--max-time") {
+            maxTime = std::atof(argv[++i]);
+        } else if (arg == "--size") {
+            mapSize = std::atoi(argv[++i]);
+        } else if (arg == "--threads") {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed") {
+            seed = std::strtoull(argv[++i], NULL, 10);
+            hasSeed = true;
+        } else if (arg == "--record") {
+            recordFile = argv[++i];
+        } else if (arg == "--replay") {
+            replayFile = argv[++i];
+        } else if (arg == "--load") {
+            loadFile = argv[++i];
+        } else if (arg == "--save") {
+            saveFile = argv[++i];
+        } else if (arg == "--profile") {
+            profileName = argv[++i];
+        } else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    if (tickRate <= 0 || matches < 1 || mapSize < 3) {
+        std::cerr << "invalid options" << std::endl;
+        return 1;
+    }
+
+    if (!hasSeed) {
+        std::random_device entropy;
+        seed = (((uint64_t)entropy() << 32) | entropy()) ^ (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    int mapRows = mapSize;
+    int mapCols = mapSize;
+    if (!replayFile.empty()) {
+        ReplayPlayer recording;
+        if (!recording.open(replayFile)) {
+            std::cerr << "can't read replay " << replayFile << std::endl;
+            return 1;
+        }
+        mapRows = recording.getHeader().rows;
+        mapCols = recording.getHeader().cols;
+        matches = 1;
+    }
+
+    if (!loadFile.empty()) {
+        if (!recordFile.empty() || !replayFile.empty()) {
+            std::cerr << "--load can't be combined with --record or --replay, they start from a new match" << std::endl;
+            return 1;
+        }
+        if (!Game::readSnapshotMapSize(loadFile, mapRows, mapCols)) {
+            std::cerr << "can't read snapshot " << loadFile << std::endl;
+            return 1;
+        }
+    }
+
+    for (int match=0; match < matches; match++) {
+        auto start = std::chrono::steady_clock::now();
+
+        Game game(1920, 1080, mapCols, mapRows);
+        game.setTickRate(tickRate);
+        game.setSeed(seed + match);
+        if (!replayFile.empty()) {
+            game.playReplay(replayFile); // overrides the seed and tick rate
+        } else if (!recordFile.empty()) {
+            game.recordTo(matches == 1 ? recordFile : recordFile + "." + std::to_string(match));
+        }
+        if (threads >= 0) {
+            game.jobs.start(threads); // worker threads besides this one
+        }
+        game.Start();
+        if (!loadFile.empty() && !game.loadSnapshot(loadFile)) {
+            std::cerr << "can't load snapshot " << loadFile << std::endl;
+            return 1;
+        }
+
+        while (game.isRunning() && game.gameTime < maxTime) {
+            game.input.clear(); // nobody is playing, the waves get a free run at the castle
+            game.tick();
+            PROFILE_FRAME(); // a frame is one tick here
+        }
+
+        if (!saveFile.empty() && !game.saveSnapshot(matches == 1 ? saveFile : saveFile + "." + std::to_string(match))) {
+            std::cerr << "can't write snapshot " << saveFile << std::endl;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "match " << match
+                  << " seed: " << game.getSeed()
+                  << " survived: " << game.gameTime << "s"
+                  << " waves: " << game.waveCount
+                  << " ticks: " << game.tickCount
+                  << " wall: " << elapsed.count() << "s" << std::endl;
+    }
+
+    if (!profileName.empty()) {
+#ifdef PROFILING
+        profiler.writeCsv(profileName + ".csv");
+        profiler.writeChromeTrace(profileName + ".json");
+#else
+        std::cerr << "--profile needs a build with make PROFILE=1" << std::endl;
+#endif
+    }
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <cmath>
+#include "../raylib.h"
+
+// stand in for the parts of raylib the game links against, so the simulation can run without a window
+// drawing, audio and texture loading do nothing, input reports nothing (the game reads its Input object instead)
+// and the pure math helpers behave like the real ones
+
+// ---- window ----
+bool WindowShouldClose(void) { return false; }
+int GetScreenWidth(void) { return 1920; }
+int GetScreenHeight(void) { return 1080; }
+float GetFrameTime(void) { return 1.0f / 60.0f; }
+double GetTime(void) { return 0; }
+
+// ---- drawing ----
+void BeginDrawing(void) {}
+void EndDrawing(void) {}
+void ClearBackground(Color color) {}
+void BeginMode2D(Camera2D camera) {}
+void EndMode2D(void) {}
+void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color) {}
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {}
+void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color color) {}
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color) {}
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {}
+void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint) {}
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {}
+
+// ---- textures, only the size the sprites are drawn at is faked ----
+Texture2D LoadTexture(const char *fileName)
+{
+    Texture2D texture = { 0 };
+    texture.width = 810;
+    texture.height = 810;
+    texture.mipmaps = 1;
+    return texture;
+}
+
+void UnloadTexture(Texture2D texture) {}
+
+// images only keep their size, there are no pixels
+Image LoadImage(const char *fileName)
+{
+    Image image = { 0 };
+    image.width = 810;
+    image.height = 810;
+    image.mipmaps = 1;
+    return image;
+}
+
+Image LoadImageFromTexture(Texture2D texture)
+{
+    Image image = { 0 };
+    image.width = texture.width;
+    image.height = texture.height;
+    image.mipmaps = 1;
+    return image;
+}
+
+Image GenImageColor(int width, int height, Color color)
+{
+    Image image = { 0 };
+    image.width = width;
+    image.height = height;
+    image.mipmaps = 1;
+    return image;
+}
+
+void ImageResize(Image *image, int newWidth, int newHeight)
+{
+    image->width = newWidth;
+    image->height = newHeight;
+}
+
+void ImageDraw(Image *dst, Image src, Rectangle srcRec, Rectangle dstRec, Color tint) {}
+void UnloadImage(Image image) {}
+
+Texture2D LoadTextureFromImage(Image image)
+{
+    Texture2D texture = { 0 };
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.mipmaps = 1;
+    return texture;
+}
+
+void GenTextureMipmaps(Texture2D *texture) {}
+void SetTextureFilter(Texture2D texture, int filter) {}
+
+// ---- text ----
+Font GetFontDefault(void)
+{
+    Font font = { 0 };
+    font.baseSize = 10;
+    return font;
+}
+
+int MeasureText(const char *text, int fontSize)
+{
+    return (int)(strlen(text) * fontSize * 0.6f);
+}
+
+Vector2 MeasureTextEx(Font font, const char *text, float fontSize, float spacing)
+{
+    int length = strlen(text);
+    Vector2 size = { length * fontSize * 0.6f + (length > 0 ? (length - 1) * spacing : 0), fontSize };
+    return size;
+}
+
+const char *TextFormat(const char *text, ...)
+{
+    static char buffers[4][1024];
+    static int index = 0;
+
+    char *buffer = buffers[index];
+    index = (index + 1) % 4;
+
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffers[0]), text, args);
+    va_end(args);
+
+    return buffer;
+}
+
+// ---- input, always idle ----
+bool IsKeyPressed(int key) { return false; }
+bool IsKeyDown(int key) { return false; }
+bool IsMouseButtonPressed(int button) { return false; }
+bool IsMouseButtonDown(int button) { return false; }
+Vector2 GetMousePosition(void) { return (Vector2){ 0, 0 }; }
+float GetMouseWheelMove(void) { return 0; }
+
+// ---- math ----
+bool CheckCollisionPointRec(Vector2 point, Rectangle rec)
+{
+    return (point.x >= rec.x) && (point.x < (rec.x + rec.width)) && (point.y >= rec.y) && (point.y < (rec.y + rec.height));
+}
+
+Vector2 GetScreenToWorld2D(Vector2 position, Camera2D camera)
+{
+    float angle = -camera.rotation * DEG2RAD;
+    float x = (position.x - camera.offset.x) / camera.zoom;
+    float y = (position.y - camera.offset.y) / camera.zoom;
+
+    Vector2 result = {
+        x * cosf(angle) - y * sinf(angle) + camera.target.x,
+        x * sinf(angle) + y * cosf(angle) + camera.target.y
+    };
+    return result;
+}
+
+// ---- audio ----
+Music LoadMusicStream(const char *fileName)
+{
+    Music music = { 0 };
+    return music;
+}
+
+bool IsMusicStreamPlaying(Music music) { return false; }
+void PlayMusicStream(Music music) {}
+void UpdateMusicStream(Music music) {}
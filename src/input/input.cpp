@@ -0,0 +1,140 @@
+#include "input.h"
+
+Input::Input()
+{
+    // only the keys the game listens to are polled from raylib
+    trackedKeys = {
+        KEY_W, KEY_A, KEY_S, KEY_D,
+        KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT,
+        KEY_C, KEY_L, KEY_F3, KEY_F4, KEY_F5, KEY_F9,
+        KEY_ONE, KEY_TWO, KEY_THREE, KEY_FOUR, KEY_FIVE
+    };
+
+    clear();
+}
+
+Input::~Input()
+{
+}
+
+void Input::poll()
+{
+    for (int i=0; i < trackedKeys.size(); i++) {
+        int key = trackedKeys.at(i);
+        keysPressed[key] = keysPressed[key] || IsKeyPressed(key); // kept until a simulation tick consumed it
+        keysDown[key] = IsKeyDown(key);
+    }
+
+    for (int i=0; i < mouseButtonCount; i++) {
+        mouseButtonsPressed[i] = mouseButtonsPressed[i] || IsMouseButtonPressed(i);
+        mouseButtonsDown[i] = IsMouseButtonDown(i);
+    }
+
+    mousePosition = GetMousePosition();
+    mouseWheelMove += GetMouseWheelMove();
+}
+
+void Input::clear()
+{
+    for (int i=0; i < keyCount; i++) {
+        keysPressed[i] = false;
+        keysDown[i] = false;
+    }
+
+    for (int i=0; i < mouseButtonCount; i++) {
+        mouseButtonsPressed[i] = false;
+        mouseButtonsDown[i] = false;
+    }
+
+    mousePosition = {0, 0};
+    mouseWheelMove = 0;
+}
+
+void Input::clearPressed()
+{
+    for (int i=0; i < keyCount; i++) {
+        keysPressed[i] = false;
+    }
+
+    for (int i=0; i < mouseButtonCount; i++) {
+        mouseButtonsPressed[i] = false;
+    }
+
+    mouseWheelMove = 0;
+}
+
+bool Input::isKeyPressed(int key)
+{
+    if (key < 0 || key >= keyCount) return false;
+    return keysPressed[key];
+}
+
+bool Input::takeKeyPressed(int key)
+{
+    if (key < 0 || key >= keyCount) return false;
+    bool isPressed = keysPressed[key];
+    keysPressed[key] = false;
+    return isPressed;
+}
+
+bool Input::isKeyDown(int key)
+{
+    if (key < 0 || key >= keyCount) return false;
+    return keysDown[key];
+}
+
+bool Input::isMouseButtonPressed(int button)
+{
+    if (button < 0 || button >= mouseButtonCount) return false;
+    return mouseButtonsPressed[button];
+}
+
+bool Input::isMouseButtonDown(int button)
+{
+    if (button < 0 || button >= mouseButtonCount) return false;
+    return mouseButtonsDown[button];
+}
+
+Vector2 Input::getMousePosition()
+{
+    return mousePosition;
+}
+
+float Input::getMouseWheelMove()
+{
+    return mouseWheelMove;
+}
+
+void Input::pressKey(int key)
+{
+    if (key < 0 || key >= keyCount) return;
+    keysPressed[key] = true;
+}
+
+void Input::setKeyDown(int key, bool down)
+{
+    if (key < 0 || key >= keyCount) return;
+    keysDown[key] = down;
+}
+
+void Input::setMousePosition(Vector2 position)
+{
+    mousePosition = position;
+}
+
+void Input::pressMouseButton(int button)
+{
+    if (button < 0 || button >= mouseButtonCount) return;
+    mouseButtonsPressed[button] = true;
+}
+
+void Input::setMouseButtonDown(int button, bool down)
+{
+    if (button < 0 || button >= mouseButtonCount) return;
+    mouseButtonsDown[button] = down;
+}
+
+void Input::setMouseWheelMove(float move)
+{
+    mouseWheelMove = move;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include "../raylib.h"
+
+// snapshot of the input for one frame, the game reads from this instead of calling raylib directly
+// so the same Update code can be driven by the keyboard/mouse or by an injected source (headless runs)
+class Input
+{
+private:
+    static const int keyCount = 512;
+    static const int mouseButtonCount = 3;
+
+    bool keysPressed[keyCount];
+    bool keysDown[keyCount];
+    bool mouseButtonsPressed[mouseButtonCount];
+    bool mouseButtonsDown[mouseButtonCount];
+
+    Vector2 mousePosition;
+    float mouseWheelMove;
+
+    std::vector<int> trackedKeys;
+public:
+    bool isKeyPressed(int key);
+    bool takeKeyPressed(int key); // for keys handled once per frame instead of per tick, uses the press up so a frame without a tick doesn't see it again
+    bool isKeyDown(int key);
+    bool isMouseButtonPressed(int button);
+    bool isMouseButtonDown(int button);
+    Vector2 getMousePosition();
+    float getMouseWheelMove();
+
+    void poll(); // read the current state from raylib, presses add up until clearPressed() so frames without a tick don't lose them
+    void clear();
+    void clearPressed(); // drop the one shot events once a tick has seen them, keep the held keys/buttons
+
+    // used to inject input when there is no window
+    void pressKey(int key);
+    void setKeyDown(int key, bool down);
+    void setMousePosition(Vector2 position);
+    void pressMouseButton(int button);
+    void setMouseButtonDown(int button, bool down);
+    void setMouseWheelMove(float move);
+
+    Input();
+    ~Input();
+};
@@ -0,0 +1,138 @@
+#include <algorithm>
+
+#include "jobSystem.h"
+
+JobSystem::JobSystem()
+{
+    isStopping = false;
+    queuedJobs = 0;
+    queues.push_back(new Queue());
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+    for (int i=0; i < queues.size(); i++) {
+        delete queues[i];
+    }
+}
+
+void JobSystem::start(int workerCount)
+{
+    stop();
+
+    isStopping = false;
+    for (int i=0; i < workerCount; i++) {
+        queues.push_back(new Queue());
+    }
+    for (int i=0; i < workerCount; i++) {
+        workers.push_back(std::thread(&JobSystem::workerLoop, this, i + 1));
+    }
+}
+
+void JobSystem::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        isStopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (int i=0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    workers.clear();
+
+    while (queues.size() > 1) { // parallelFor doesn't return with jobs left, so these are empty
+        delete queues.back();
+        queues.pop_back();
+    }
+}
+
+void JobSystem::push(int queue, std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+        queues[queue]->jobs.push_back(job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedJobs++;
+    }
+    wakeUp.notify_one();
+}
+
+bool JobSystem::popOrSteal(int self, std::function<void()> &job)
+{
+    {
+        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+        if (!queues[self]->jobs.empty()) {
+            job = queues[self]->jobs.back();
+            queues[self]->jobs.pop_back();
+            queuedJobs--;
+            return true;
+        }
+    }
+
+    for (int offset=1; offset < queues.size(); offset++) {
+        Queue *victim = queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim->mutex);
+        if (!victim->jobs.empty()) {
+            job = victim->jobs.front();
+            victim->jobs.pop_front();
+            queuedJobs--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(int self)
+{
+    std::function<void()> job;
+    while (!isStopping) {
+        if (popOrSteal(self, job)) {
+            job();
+            continue;
+        }
+
+        // push counts the job under sleepMutex before notifying, so checking and going to sleep under it can't miss one
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return isStopping || queuedJobs > 0; });
+    }
+}
+
+void JobSystem::parallelFor(int count, int grainSize, const std::function<void(int, int)> &body)
+{
+    if (grainSize < 1) {
+        grainSize = 1;
+    }
+    if (workers.empty() || count <= grainSize) {
+        body(0, count);
+        return;
+    }
+
+    int chunkCount = (count + grainSize - 1) / grainSize;
+    std::atomic<int> remaining(chunkCount);
+    for (int chunk=0; chunk < chunkCount; chunk++) {
+        int begin = chunk * grainSize;
+        int end = std::min(begin + grainSize, count);
+        push(chunk % queues.size(), [this, &body, &remaining, begin, end] {
+            body(begin, end);
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            remaining--;
+            if (remaining == 0) {
+                loopDone.notify_all();
+            }
+        });
+    }
+
+    std::function<void()> job;
+    while (popOrSteal(0, job)) {
+        job();
+    }
+
+    // the last chunks are running on other threads
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    loopDone.wait(lock, [&remaining] { return remaining == 0; });
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// a few worker threads that split loops over units between them
+// every thread has its own queue, it takes work from the back of its own queue and steals from the front of the others
+// the thread that calls parallelFor works along until the whole loop is done, so with 0 workers everything runs inline
+class JobSystem
+{
+private:
+    struct Queue
+    {
+        std::deque<std::function<void()>> jobs;
+        std::mutex mutex;
+    };
+
+    std::vector<Queue*> queues; // queues[0] belongs to the thread calling parallelFor, the rest to the workers
+    std::vector<std::thread> workers;
+    std::atomic<bool> isStopping;
+    std::atomic<int> queuedJobs;
+    std::mutex sleepMutex; // held while queuedJobs or isStopping change, so a sleeping thread can't miss the notify
+    std::condition_variable wakeUp; // workers sleep on it until there is work or they have to stop
+    std::condition_variable loopDone; // parallelFor sleeps on it until the last chunk of its loop is done
+
+    void push(int queue, std::function<void()> job);
+    bool popOrSteal(int self, std::function<void()> &job);
+    void workerLoop(int self);
+public:
+    void start(int workerCount); // stops the current workers first
+    void stop();
+    int getWorkerCount() { return workers.size(); }
+
+    // calls body(begin, end) for chunks of at most grainSize indices of [0, count) and returns when all are done
+    // chunks run in any order on any thread, so body may only write to data of its own indices
+    void parallelFor(int count, int grainSize, const std::function<void(int, int)> &body);
+
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    JobSystem& operator=(const JobSystem &) = delete;
+};
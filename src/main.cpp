@@ -1,5 +1,8 @@
 #include <vector>
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
 #include "raylib.h"
 
 #include "ui/menu.h"
@@ -11,9 +14,22 @@
 int screenWidth = 0;
 int screenHeight = 0;
 
-int main()
+int main(int argc, char *argv[])
 {
     bool quitGame = false;
+
+    // ./a.out --replay file watches a recorded match instead of showing the menu
+    // ./a.out --size n plays on an n x n map
+    std::string replayFile;
+    int mapSize = 17;
+    for (int i=1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--replay") {
+            replayFile = argv[i + 1];
+        } else if (arg == "--size") {
+            mapSize = std::max(3, std::atoi(argv[i + 1]));
+        }
+    }
     
     InitWindow(0, 0, "SeaFishilisation I");
     SetTargetFPS(60);
@@ -32,6 +48,20 @@ int main()
     menu = Menu(screenWidth, screenHeight);
     settingsMenu = Settings(screenWidth, screenHeight);
 
+    if (!replayFile.empty()) {
+        ReplayPlayer recording;
+        if (recording.open(replayFile)) {
+            loadingScreen(100, screenWidth, screenHeight);
+            Game game(screenWidth, screenHeight, recording.getHeader().cols, recording.getHeader().rows);
+            if (game.playReplay(replayFile)) {
+                game.run();
+            }
+        } else {
+            std::cerr << "can't read replay " << replayFile << std::endl;
+        }
+        quitGame = true;
+    }
+
     // for the main menu maybe add 
 
     while (!quitGame) // dit is de gameloop voor het mainMenu deze zolang deze acttief is runt de game
@@ -46,7 +76,8 @@ int main()
         if (menu.buttonPressed == 0) // optie 1 start game
         {
             loadingScreen(100, screenWidth, screenHeight);
-            Game game(screenWidth, screenHeight, 17, 17);
+            Game game(screenWidth, screenHeight, mapSize, mapSize);
+            game.recordTo("lastMatch.replay"); // overwritten every match, keep it when a match was slow
             game.run();
         }
         else if (menu.buttonPressed == 1) // optie 2 settings
@@ -65,5 +96,6 @@ int main()
         }
     }
 
+    textureCache.unloadAll();
     return 0;
 }
\ No newline at end of file
@@ -1,37 +1,43 @@
+#include <cstdlib>
+
 #include "map.h"
+#include "../profiler/profiler.h"
 
-Map::Map(int rowCount, int columnCount, std::map<std::string, Texture2D> tileTextures_) 
+Map::Map(int rowCount, int columnCount, TextureRegistry *textures_) 
 {
     rows = rowCount;
     cols = columnCount;
-    tileTextures = tileTextures_;
+    textures = textures_;
+    typeVersion = 0;
+    typeChangesStart = 0;
 
-    lockedTileTypes = {
-        "locked",
-        "castleV1",
-        "castleV2",
-        "castleV3",
-        "castleV4",
-        "castleV5"
-    };
+    for (int i = 0; i < TILE_TYPE_COUNT; i++) {
+        tileTextures[i] = textures != NULL ? textures->getHandle(tileTypeName(TileType(i))) : NO_TEXTURE;
+    }
 
-    whiteHighlightTileTexture = LoadTexture("sprites/UI-elements/hexHighlight.png");
-    redHighlightTileTexture = LoadTexture("sprites/UI-elements/hexRedHighlight.png");
+    whiteHighlightTileTexture = textures != NULL ? textures->getHandle("hexHighlight") : NO_TEXTURE;
+    redHighlightTileTexture = textures != NULL ? textures->getHandle("hexRedHighlight") : NO_TEXTURE;
 
     tileWidth = 100;
     tileHeight = 115;
-    tileMap.resize(rows, std::vector<Tile>(cols, Tile(0, 0, 0.13, 0.13, tileTextures, "sea" ))); 
+
+    if (textures != NULL) {
+        atlas.build(textures, tileTextures, 512); // a tile is 115 high and the camera zooms in up to 4 times
+    }
+    tiles.reserve(rows * cols);
     
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < cols; ++j) {
             if (i % 2 == 0) {
-                tileMap.at(i).at(j) = Tile(i*tileWidth, j*tileHeight, tileWidth, tileHeight, tileTextures, "sea"); // tile location based on tiles with a size of 1024 x 1024
+                tiles.push_back(Tile(i*tileWidth, j*tileHeight, tileWidth, tileHeight, tileTextures[TILE_SEA], TILE_SEA)); // tile location based on tiles with a size of 1024 x 1024
             } else {
-                tileMap.at(i).at(j) = Tile(i*tileWidth, j*tileHeight-tileHeight/2, tileWidth, tileHeight, tileTextures, "sea");
+                tiles.push_back(Tile(i*tileWidth, j*tileHeight-tileHeight/2, tileWidth, tileHeight, tileTextures[TILE_SEA], TILE_SEA));
             }
         }
     }
-    tileMap.at(rows/2).at(cols/2).changeType("castleV1");
+    tileAt(rows/2, cols/2).changeType(TILE_CASTLE_V1, tileTextures[TILE_CASTLE_V1]);
+
+    recountTileTypes();
 }
 
 Map::~Map()
@@ -39,83 +45,147 @@ Map::~Map()
 
 }
 
-void Map::Update(double dt) {
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            tileMap.at(i).at(j).Update(dt);
-        }
+void Map::forgetTypeChanges(int version)
+{
+    int count = std::min(version, typeVersion) - typeChangesStart;
+    if (count > 0) {
+        typeChanges.erase(typeChanges.begin(), typeChanges.begin() + count);
+        typeChangesStart += count;
+    }
+}
+
+void Map::startTraining(Vector2 coord, double doneTime) {
+    Tile *tile = getTile(coord);
+    tile->isTraining = true;
+    tile->trainingDoneTime = doneTime;
+}
+
+void Map::finishTraining(int index) {
+    if (index >= 0 && index < tiles.size()) {
+        tiles[index].isTraining = false;
     }
 }
 
 
 Tile* Map::getTile(Vector2 coord) {
-    if(coord.y >= rows) {
-        coord.y = rows - 1;
+    return &tiles[getTileIndex(coord)];
+}
+
+int Map::getTileIndex(Vector2 coord) {
+    int x = coord.x;
+    int y = coord.y;
+
+    if (x >= rows) {
+        x = rows - 1;
     }
-    if (coord.x >= cols) {
-        coord.x = cols - 1;
+    if (y >= cols) {
+        y = cols - 1;
     }
-    if (coord.y < 0) {
-        coord.y = 0;
+    if (x < 0) {
+        x = 0;
     }
-    if (coord.x < 0) {
-        coord.x = 0;
+    if (y < 0) {
+        y = 0;
     }
-    return &tileMap.at(coord.x).at(coord.y);
+    return tileIndex(x, y);
 }
 
-void Map::draw() {
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            tileMap.at(i).at(j).draw();
+Tile& Map::tileAtChecked(int x, int y) {
+    if (!isInside(x, y)) {
+        throw std::out_of_range("tile coord outside of the map");
+    }
+    return tiles.at(x * cols + y);
+}
+
+void Map::getVisibleRange(Camera2D camera, int &minX, int &minY, int &maxX, int &maxY) {
+    Vector2 topLeft = worldPosToGridPos(GetScreenToWorld2D({0, 0}, camera));
+    Vector2 bottomRight = worldPosToGridPos(GetScreenToWorld2D({(float)GetScreenWidth(), (float)GetScreenHeight()}, camera));
+
+    // sprites are wider than a column and odd columns sit half a tile higher, one tile of padding covers both
+    minX = std::max((int)topLeft.x - 1, 0);
+    minY = std::max((int)topLeft.y - 1, 0);
+    maxX = std::min((int)bottomRight.x + 1, rows - 1);
+    maxY = std::min((int)bottomRight.y + 1, cols - 1);
+}
+
+void Map::draw(Camera2D camera) {
+    PROFILE_ZONE("Map::draw");
+    int minX, minY, maxX, maxY;
+    getVisibleRange(camera, minX, minY, maxX, maxY);
+
+    if (!atlas.isBuilt()) {
+        for (int x = minX; x <= maxX; x++) {
+            for (int y = minY; y <= maxY; y++) {
+                tileAt(x, y).draw(textures);
+            }
+        }
+        return;
+    }
+
+    // the whole tile layer from one texture, so raylib doesn't have to flush its batch between tiles
+    Texture2D &atlasTexture = textures->get(atlas.getTexture());
+    for (int x = minX; x <= maxX; x++) {
+        for (int y = minY; y <= maxY; y++) {
+            Tile &tile = tileAt(x, y);
+            Vector2 pos = tile.getPos();
+            Rectangle dest = {pos.x, pos.y, (float)tileHeight, (float)tileHeight}; // the sprites are square, drawn at the tile height
+            DrawTexturePro(atlasTexture, atlas.getCell(tile.getType()), dest, {0, 0}, 0, WHITE);
         }
     }
 }
 
-void Map::drawGhostTile(Vector2 coord, std::string type, bool isPlacementAllowed) 
+void Map::drawGhostTile(Vector2 coord, TileType type, bool isPlacementAllowed) 
 {
-    Texture2D texture = tileTextures[type];
+    Texture2D texture = textures->get(tileTextures[type]);
 
     Tile* tile = getTile(coord);
 
-    bool isInLockedTileTypes = (std::find(lockedTileTypes.begin(), lockedTileTypes.end(), tile->getType()) != lockedTileTypes.end());
-    if(isInLockedTileTypes) {
+    if(isTileTypeLocked(tile->getType())) {
         return;
     }
 
     Vector2 pos = tile->getPos();
-    double scale = (double) tileHeight / 810;
+    double scale = (double) tileHeight / texture.height;
     DrawTextureEx(texture, pos, 0, scale, WHITE);
-    if(isPlacementAllowed) {
-        DrawTextureEx(whiteHighlightTileTexture, tile->getPos(), 0, (double) tileHeight / 810, WHITE);
-    } else {
-        DrawTextureEx(redHighlightTileTexture, tile->getPos(), 0, (double) tileHeight / 810, WHITE);
-    }
+    Texture2D &highlight = textures->get(isPlacementAllowed ? whiteHighlightTileTexture : redHighlightTileTexture);
+    DrawTextureEx(highlight, tile->getPos(), 0, (double) tileHeight / highlight.height, WHITE);
     
     tile = NULL;
 }
 
-std::string Map::getTileType(Vector2 coord) {
+TileType Map::getTileType(Vector2 coord) {
     Tile* tile = getTile(coord);
     return tile->getType();
 } 
 
-bool Map::isTileAvailable(Vector2 coord, std::string type) {
-    bool isInLockedTileTypes = (std::find(lockedTileTypes.begin(), lockedTileTypes.end(), getTileType(coord)) != lockedTileTypes.end());
-    if(isInLockedTileTypes || getTileType(coord) == type) {
+bool Map::isTileAvailable(Vector2 coord, TileType type) {
+    TileType currentType = getTileType(coord);
+    if(isTileTypeLocked(currentType) || currentType == type) {
         return false;
     }
     return true;
 }
 
 bool Map::isTileLocked(Vector2 coord) {
-    bool isInLockedTileTypes = (std::find(lockedTileTypes.begin(), lockedTileTypes.end(), getTileType(coord)) != lockedTileTypes.end());
-    return isInLockedTileTypes;
+    return isTileTypeLocked(getTileType(coord));
 }
 
-void Map::changeTileType(Vector2 coord, std::string type) {
+void Map::changeTileType(Vector2 coord, TileType type) {
     Tile *useTile = getTile(coord);
-    useTile->changeType(type);
+    tileTypeCounts[useTile->getType()]--;
+    tileTypeCounts[type]++;
+    useTile->changeType(type, tileTextures[type]);
+    typeChanges.push_back(useTile - &tiles[0]); // getTile clamps, so log the tile that really changed
+    typeVersion++;
+}
+
+void Map::recountTileTypes() {
+    for (int i = 0; i < TILE_TYPE_COUNT; i++) {
+        tileTypeCounts[i] = 0;
+    }
+    for (int i = 0; i < tiles.size(); i++) {
+        tileTypeCounts[tiles[i].getType()]++;
+    }
 }
 
 Vector2 Map::worldPosToGridPos(Vector2 coord) 
@@ -233,37 +303,81 @@ std::vector<Vector2> Map::getSurroundingCoords(Vector2 coord)
 }
 
 bool Map::isSurrounded(Vector2 coord) {
-    std::vector<std::string> buildTileTypes = {
-        "food",
-        "coral",
-        "training",
-        "castleV1",
-        "castleV2",
-        "castleV3",
-        "castleV4",
-        "castleV5"
-    };
-
     std::vector<Vector2> surroundingCoords = getSurroundingCoords(coord);
     for(int i = 0; i < surroundingCoords.size(); i++) {
-        bool isInBuildTileTypes = 
-            (std::find(buildTileTypes.begin(), buildTileTypes.end(), getTileType(surroundingCoords.at(i))) != buildTileTypes.end());
-        
-        if(isInBuildTileTypes) {
+        if(getTileTypeInfo(getTileType(surroundingCoords.at(i))).partOfBase) {
             return true;
         }
     }
     return false;
 }
 
-int Map::countTilesWithType(std::string type) {
+int Map::countTilesWithType(TileType type) {
+    PROFILE_ZONE("Map::countTilesWithType");
+#ifdef MAP_VERIFY_TILE_COUNTS
+    int scanned = countTilesWithTypeScan(type);
+    if (scanned != tileTypeCounts[type]) {
+        std::cerr << "tile count for " << tileTypeName(type) << " is " << tileTypeCounts[type] << " but the map has " << scanned << std::endl;
+        std::abort();
+    }
+#endif
+    return tileTypeCounts[type];
+}
+
+int Map::countTilesWithTypeScan(TileType type) {
     int count = 0;
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            if (getTileType({i, j}) == type) {
-                count++;
-            }
+    for (int i = 0; i < tiles.size(); i++) {
+        if (tiles[i].getType() == type) {
+            count++;
         }
     }
     return count;
 }
+
+void Map::saveState(SnapshotWriter &writer)
+{
+    std::vector<uint8_t> types(tiles.size());
+    std::vector<uint8_t> training(tiles.size());
+    std::vector<double> doneTimes(tiles.size());
+    for (int i = 0; i < tiles.size(); i++) {
+        types[i] = tiles[i].getType();
+        training[i] = tiles[i].isTraining;
+        doneTimes[i] = tiles[i].trainingDoneTime;
+    }
+
+    writer.write(rows);
+    writer.write(cols);
+    writer.writeArray(types);
+    writer.writeArray(training);
+    writer.writeArray(doneTimes);
+}
+
+bool Map::loadState(SnapshotReader &reader)
+{
+    int savedRows, savedCols;
+    std::vector<uint8_t> types, training;
+    std::vector<double> doneTimes;
+    reader.read(savedRows);
+    reader.read(savedCols);
+    reader.readArray(types);
+    reader.readArray(training);
+    reader.readArray(doneTimes);
+    if (reader.hasFailed() || savedRows != rows || savedCols != cols || types.size() != tiles.size() || training.size() != tiles.size() || doneTimes.size() != tiles.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < tiles.size(); i++) {
+        if (types[i] >= TILE_TYPE_COUNT) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < tiles.size(); i++) {
+        if (tiles[i].getType() != types[i]) {
+            changeTileType({(float)(i / cols), (float)(i % cols)}, (TileType)types[i]); // keeps the counts and the change log right
+        }
+        tiles[i].isTraining = training[i];
+        tiles[i].trainingDoneTime = doneTimes[i];
+    }
+    return true;
+}
@@ -5,39 +5,76 @@
 #include <cmath>
 #include <map>
 #include <string>
+#include <stdexcept>
 #include "../raylib.h"
 
 #include "tile.h"
+#include "tileType.h"
+#include "tileAtlas.h"
+#include "../textures/textureRegistry.h"
+#include "../save/snapshot.h"
 
 class Map
 {
 private:
-    std::vector<std::vector<Tile>> tileMap;
-    std::vector<std::string> lockedTileTypes;
-    
-    std::map<std::string, Texture2D> tileTextures;
-    Texture2D whiteHighlightTileTexture;
-    Texture2D redHighlightTileTexture;
+    std::vector<Tile> tiles; // rows * cols tiles in one block, tile (x, y) is at x * cols + y
+    TextureRegistry *textures;
+    TextureHandle tileTextures[TILE_TYPE_COUNT]; // texture of every tile type, looked up once by name
+    int tileTypeCounts[TILE_TYPE_COUNT]; // kept up to date by changeTileType, so tile types must only be changed through the map
+    TileAtlas atlas;
+
+    void recountTileTypes();
+
+    TextureHandle whiteHighlightTileTexture;
+    TextureHandle redHighlightTileTexture;
     
 public:
     int rows, cols;
     int tileHeight, tileWidth;
+    int typeVersion; // goes up every time changeTileType is called, so caches built from tile types know when they are stale
+    std::vector<int> typeChanges; // tile index of every changeTileType call not read yet, entry v moved typeVersion from typeChangesStart + v one up
+    int typeChangesStart; // typeVersion before typeChanges[0]
+    void forgetTypeChanges(int version); // the reader is up to date with version, drops the entries before it
     Vector2 worldPosToGridPos(Vector2 coord);
     Vector2 gridPosToWorldPos(Vector2 coord);
 std::vector<Vector2> getBorders();
     std::vector<Vector2> getSurroundingCoords(Vector2 coord);
     std::vector<Vector2> getSurroundingCoordsEnemy(Vector2 coord);
     bool isSurrounded(Vector2 coord);
-    void drawGhostTile(Vector2 coord, std::string type, bool isPlacementAllowed);
-    std::string getTileType(Vector2 coord);
-    bool isTileAvailable(Vector2 coord, std::string type);
+    void drawGhostTile(Vector2 coord, TileType type, bool isPlacementAllowed);
+    TileType getTileType(Vector2 coord);
+    bool isTileAvailable(Vector2 coord, TileType type);
     bool isTileLocked(Vector2 coord);
-    void changeTileType(Vector2 coord, std::string type);
-    int countTilesWithType(std::string type);
-    void Update(double dt);
-    void draw();
-    Tile* getTile(Vector2 coord);
+    void changeTileType(Vector2 coord, TileType type);
+    int countTilesWithType(TileType type); // O(1), build with -DMAP_VERIFY_TILE_COUNTS to check it against a full scan
+    int countTilesWithTypeScan(TileType type);
+    void startTraining(Vector2 coord, double doneTime); // the game schedules the EVENT_TRAINING_DONE that calls finishTraining
+    void finishTraining(int index);
+    Vector2 getCastleCoord() { return {(float)(rows / 2), (float)(cols / 2)}; } // the castle is always in the middle
+    void saveState(SnapshotWriter &writer); // tile types and trainings
+    bool loadState(SnapshotReader &reader); // false and unchanged when the snapshot is for another map size
+    void draw(Camera2D camera); // only the tiles the camera can see
+    void getVisibleRange(Camera2D camera, int &minX, int &minY, int &maxX, int &maxY); // grid coords on screen, padded by one tile and clamped to the map
+    Tile* getTile(Vector2 coord); // clamps coord to the map
+    int getTileIndex(Vector2 coord); // clamps like getTile
+
+    bool isInside(int x, int y) { return x >= 0 && x < rows && y >= 0 && y < cols; }
+    Tile& tileAt(int x, int y) { return tiles[x * cols + y]; } // no bounds check, for loops that already know the coord is inside
+    Tile& tileAtChecked(int x, int y); // same as tileAt but throws std::out_of_range, for debugging
+    int tileCount() { return tiles.size(); }
+    Tile& tileAtIndex(int index) { return tiles[index]; } // for sweeps over the whole map in memory order
+    int tileIndex(int x, int y) { return x * cols + y; }
+
+    // neighbour 0-5 of (x, y) in the same order as getSurroundingCoordsEnemy, without building a vector
+    // the result can be outside of the map
+    static void getNeighbour(int x, int y, int direction, int &neighbourX, int &neighbourY) {
+        static const int oddOffsets[6][2] = { {0, -1}, {1, -1}, {1, 0}, {0, 1}, {-1, 0}, {-1, -1} };
+        static const int evenOffsets[6][2] = { {0, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0} };
+        const int (*offsets)[2] = (x % 2 == 1) ? oddOffsets : evenOffsets;
+        neighbourX = x + offsets[direction][0];
+        neighbourY = y + offsets[direction][1];
+    }
 
-    Map(int rowCount = 17, int columnCount = 17, std::map<std::string, Texture2D> tileTextures_ = std::map<std::string, Texture2D>());
+    Map(int rowCount = 17, int columnCount = 17, TextureRegistry *textures_ = NULL);
     ~Map();
 };
\ No newline at end of file
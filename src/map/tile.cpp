@@ -1,53 +1,35 @@
 #include "map.h"
 
-Tile::Tile(int x, int y, int w, int h, std::map<std::string, Texture2D>& tileTextures, std::string type_)
+Tile::Tile(int x, int y, int w, int h, TextureHandle texture_, TileType type_)
 {
-    unitOnTile = NULL;
-    isUnitOnTile = false;
-    isAccesible = true;
     isTraining = false;
-    trainingCooldown = 0;
+    trainingDoneTime = 0;
 
     pos.x = x;
     pos.y = y;
     width = w;
     height = h;
-    textures = tileTextures;
+    texture = texture_;
     type = type_;
 }
 
 Tile::~Tile() 
 {
-    unitOnTile = NULL;
-}
-
-void Tile::Update(double dt) {
-    if (isTraining) {
-        trainingCooldown -= dt;
-
-        if (trainingCooldown <= 0) {
-            trainingCooldown = 0;
-            isTraining = false;
-        }
-    }
 }
 
 Vector2 Tile::getPos() {
     return pos;
 }
 
-std::string Tile::getType() {
-    return type;
-}
-
-void Tile::changeType(std::string newType) 
+void Tile::changeType(TileType newType, TextureHandle newTexture) 
 {
     type = newType;
+    texture = newTexture;
 }
 
-void Tile::draw() 
+void Tile::draw(TextureRegistry *textures) 
 {
-    Texture2D texture = textures[type];
-    double scale = (double) height / 810;
-    DrawTextureEx(texture, pos, 0, scale, WHITE);
+    Texture2D &sprite = textures->get(texture);
+    double scale = (double) height / sprite.height; // baked sprites are smaller than the 810px sources
+    DrawTextureEx(sprite, pos, 0, scale, WHITE);
 }
\ No newline at end of file
@@ -2,37 +2,29 @@
 #include <map>
 #include <string>
 #include "../raylib.h"
-
-// #include "../units/unit.h"
-
-// Forward declaration of Unit class, because of cicular dependicy
-class Unit;
+#include "../textures/textureRegistry.h"
+#include "tileType.h"
 
 class Tile 
 {
 private: 
-    std::string type;
-    std::map<std::string, Texture2D> textures;
+    TileType type;
+    TextureHandle texture;
     Vector2 pos;
 
 public:
-    Unit *unitOnTile;
-    bool isUnitOnTile;
     bool tileSelected;
-    bool isAccesible;
     bool isTraining;
-    double trainingCooldown;
+    double trainingDoneTime; // game time, only meaningful while isTraining
     
     int width;
     int height;
     
     Vector2 getPos();
-    std::string getType();
-    void changeType(std::string newType);
-    void draw();
-
-    void Update(double dt);
+    TileType getType() { return type; }
+    void changeType(TileType newType, TextureHandle newTexture);
+    void draw(TextureRegistry *textures);
 
-    Tile(int x, int y, int w, int h, std::map<std::string, Texture2D>& tileTextures, std::string type_);
+    Tile(int x, int y, int w, int h, TextureHandle texture_, TileType type_);
     ~Tile();
 };
\ No newline at end of file
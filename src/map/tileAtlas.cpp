@@ -0,0 +1,40 @@
+#include "tileAtlas.h"
+
+TileAtlas::TileAtlas()
+{
+    texture = NO_TEXTURE;
+    cellSize = 0;
+    for (int i = 0; i < TILE_TYPE_COUNT; i++) {
+        cells[i] = {0, 0, 0, 0};
+    }
+}
+
+TileAtlas::~TileAtlas()
+{
+
+}
+
+void TileAtlas::build(TextureRegistry *textures, const TextureHandle tileTextures[TILE_TYPE_COUNT], int setCellSize)
+{
+    cellSize = setCellSize;
+    int columns = 4;
+    int rows = (TILE_TYPE_COUNT + columns - 1) / columns;
+
+    Image atlas = GenImageColor(columns * cellSize, rows * cellSize, BLANK);
+    for (int i = 0; i < TILE_TYPE_COUNT; i++) {
+        // read back from the gpu once at load time, so the sprite paths stay in one place (Game::Game)
+        Image sprite = LoadImageFromTexture(textures->get(tileTextures[i]));
+        ImageResize(&sprite, cellSize, cellSize);
+
+        cells[i] = {(float)((i % columns) * cellSize), (float)((i / columns) * cellSize), (float)cellSize, (float)cellSize};
+        ImageDraw(&atlas, sprite, {0, 0, (float)cellSize, (float)cellSize}, cells[i], WHITE);
+        UnloadImage(sprite);
+    }
+
+    Texture2D atlasTexture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    GenTextureMipmaps(&atlasTexture); // zoomed out tiles are drawn a lot smaller than the cells
+    SetTextureFilter(atlasTexture, TEXTURE_FILTER_TRILINEAR);
+
+    texture = textures->add("tileAtlas", atlasTexture);
+}
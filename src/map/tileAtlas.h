@@ -0,0 +1,24 @@
+#pragma once
+#include "../raylib.h"
+
+#include "tileType.h"
+#include "../textures/textureRegistry.h"
+
+// every tile sprite packed into one texture at the size tiles are drawn at when zoomed in all the way
+// drawing all tiles from the same texture lets raylib keep them in one render batch, it only flushes when the batch is full
+class TileAtlas
+{
+private:
+    TextureHandle texture; // the packed texture is owned by the registry
+    Rectangle cells[TILE_TYPE_COUNT];
+public:
+    int cellSize;
+
+    void build(TextureRegistry *textures, const TextureHandle tileTextures[TILE_TYPE_COUNT], int setCellSize);
+    bool isBuilt() { return texture != NO_TEXTURE; }
+    TextureHandle getTexture() { return texture; }
+    Rectangle getCell(TileType type) { return cells[type]; }
+
+    TileAtlas();
+    ~TileAtlas();
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// every kind of tile, the names in tileTypeInfo are only used for loading textures and for the ui
+enum TileType : uint8_t
+{
+    TILE_LOCKED,
+    TILE_SEA,
+    TILE_FOOD,
+    TILE_CORAL,
+    TILE_TRAINING,
+    TILE_CASTLE_V1,
+    TILE_CASTLE_V2,
+    TILE_CASTLE_V3,
+    TILE_CASTLE_V4,
+    TILE_CASTLE_V5,
+    TILE_TYPE_COUNT,
+    TILE_NONE = TILE_TYPE_COUNT // no tile selected / unknown name
+};
+
+struct TileTypeInfo
+{
+    const char *name;
+    bool locked; // nothing can be build on it and units can't walk over it
+    bool buildable; // can be placed by the player from the build menu
+    bool partOfBase; // new tiles can be placed next to it
+    bool producing; // gives resources every production tick
+    int castleLevel; // 0 when the tile is not a castle
+};
+
+constexpr TileTypeInfo tileTypeInfo[TILE_TYPE_COUNT] = {
+    // name        locked  buildable  partOfBase  producing  castleLevel
+    { "locked",    true,   false,     false,      false,     0 },
+    { "sea",       false,  false,     false,      false,     0 },
+    { "food",      false,  true,      true,       true,      0 },
+    { "coral",     false,  true,      true,       true,      0 },
+    { "training",  false,  true,      true,       false,     0 },
+    { "castleV1",  true,   false,     true,       false,     1 },
+    { "castleV2",  true,   false,     true,       false,     2 },
+    { "castleV3",  true,   false,     true,       false,     3 },
+    { "castleV4",  true,   false,     true,       false,     4 },
+    { "castleV5",  true,   false,     true,       false,     5 },
+};
+
+constexpr const TileTypeInfo& getTileTypeInfo(TileType type) { return tileTypeInfo[type]; }
+constexpr bool isTileTypeLocked(TileType type) { return tileTypeInfo[type].locked; }
+constexpr bool isTileTypeCastle(TileType type) { return tileTypeInfo[type].castleLevel > 0; }
+constexpr TileType castleTileType(int level) { return TileType(TILE_CASTLE_V1 + level - 1); }
+
+inline const char* tileTypeName(TileType type)
+{
+    if (type >= TILE_TYPE_COUNT) {
+        return "";
+    }
+    return tileTypeInfo[type].name;
+}
+
+inline TileType tileTypeFromName(const std::string &name)
+{
+    for (int i = 0; i < TILE_TYPE_COUNT; i++) {
+        if (name == tileTypeInfo[i].name) {
+            return TileType(i);
+        }
+    }
+    return TILE_NONE;
+}
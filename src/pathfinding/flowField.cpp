@@ -0,0 +1,209 @@
+#include <algorithm>
+
+#include "flowField.h"
+#include "../profiler/profiler.h"
+
+const int FlowField::UNREACHABLE;
+
+FlowField::FlowField(Map *setMap)
+{
+    map = setMap;
+    goal = -1;
+    mapVersion = 0;
+}
+
+FlowField::~FlowField()
+{
+    map = NULL;
+}
+
+bool FlowField::isWalkable(int tile)
+{
+    // same rules as UnitWorld::canEnter, borders and locked tiles can't be walked on
+    int x = tile / map->cols;
+    int y = tile % map->cols;
+    if (x < 1 || x > map->rows - 2 || y < 1 || y > map->cols - 2) {
+        return false;
+    }
+    return !isTileTypeLocked(map->tileAtIndex(tile).getType());
+}
+
+void FlowField::setGoal(int tile)
+{
+    goal = tile;
+    rebuild();
+}
+
+void FlowField::rebuild()
+{
+    int tileCount = map->tileCount();
+    distance.assign(tileCount, UNREACHABLE);
+    walkable.resize(tileCount);
+    for (int i=0; i < tileCount; i++) {
+        walkable[i] = isWalkable(i);
+    }
+    mapVersion = map->typeVersion;
+    map->forgetTypeChanges(mapVersion);
+
+    if (goal < 0 || goal >= tileCount) {
+        return;
+    }
+
+    distance[goal] = 0;
+    queue.clear();
+    queue.push_back(goal);
+    propagate();
+}
+
+void FlowField::propagate()
+{
+    for (int head=0; head < queue.size(); head++) {
+        int current = queue[head];
+        int x = current / map->cols;
+        int y = current % map->cols;
+
+        for (int direction=0; direction < 6; direction++) {
+            int neighbourX, neighbourY;
+            Map::getNeighbour(x, y, direction, neighbourX, neighbourY);
+            if (!map->isInside(neighbourX, neighbourY)) {
+                continue;
+            }
+
+            int neighbour = map->tileIndex(neighbourX, neighbourY);
+            if (walkable[neighbour] && distance[current] + 1 < distance[neighbour]) {
+                distance[neighbour] = distance[current] + 1;
+                queue.push_back(neighbour);
+            }
+        }
+    }
+    queue.clear();
+}
+
+void FlowField::openTile(int tile)
+{
+    // a new shortcut can only make distances smaller, so take the best neighbour and spread from there
+    int x = tile / map->cols;
+    int y = tile % map->cols;
+    for (int direction=0; direction < 6; direction++) {
+        int neighbourX, neighbourY;
+        Map::getNeighbour(x, y, direction, neighbourX, neighbourY);
+        if (!map->isInside(neighbourX, neighbourY)) {
+            continue;
+        }
+
+        int neighbour = map->tileIndex(neighbourX, neighbourY);
+        if (canStepFrom(neighbour) && distance[neighbour] != UNREACHABLE && distance[neighbour] + 1 < distance[tile]) {
+            distance[tile] = distance[neighbour] + 1;
+        }
+    }
+
+    if (distance[tile] != UNREACHABLE) {
+        queue.push_back(tile);
+        propagate();
+    }
+}
+
+void FlowField::closeTile(int tile)
+{
+    // cut off every tile whose shortest way led over the closed tile and has no other neighbour one step closer
+    raised.clear();
+    raised.push_back({tile, distance[tile]});
+    distance[tile] = UNREACHABLE;
+
+    for (int head=0; head < raised.size(); head++) {
+        int current = raised[head].first;
+        int oldDistance = raised[head].second;
+        if (oldDistance == UNREACHABLE) {
+            continue;
+        }
+
+        int x = current / map->cols;
+        int y = current % map->cols;
+        for (int direction=0; direction < 6; direction++) {
+            int neighbourX, neighbourY;
+            Map::getNeighbour(x, y, direction, neighbourX, neighbourY);
+            if (!map->isInside(neighbourX, neighbourY)) {
+                continue;
+            }
+
+            int neighbour = map->tileIndex(neighbourX, neighbourY);
+            if (neighbour == goal || !walkable[neighbour] || distance[neighbour] != oldDistance + 1) {
+                continue;
+            }
+
+            bool isSupported = false;
+            for (int other=0; other < 6 && !isSupported; other++) {
+                int otherX, otherY;
+                Map::getNeighbour(neighbourX, neighbourY, other, otherX, otherY);
+                if (map->isInside(otherX, otherY)) {
+                    int otherTile = map->tileIndex(otherX, otherY);
+                    isSupported = canStepFrom(otherTile) && distance[otherTile] == oldDistance;
+                }
+            }
+
+            if (!isSupported) {
+                raised.push_back({neighbour, distance[neighbour]});
+                distance[neighbour] = UNREACHABLE;
+            }
+        }
+    }
+
+    // fill the cut off tiles again from the tiles around them that kept their distance
+    for (int i=0; i < raised.size(); i++) {
+        int current = raised[i].first;
+        if (!walkable[current]) {
+            continue;
+        }
+
+        int x = current / map->cols;
+        int y = current % map->cols;
+        for (int direction=0; direction < 6; direction++) {
+            int neighbourX, neighbourY;
+            Map::getNeighbour(x, y, direction, neighbourX, neighbourY);
+            if (!map->isInside(neighbourX, neighbourY)) {
+                continue;
+            }
+
+            int neighbour = map->tileIndex(neighbourX, neighbourY);
+            if (canStepFrom(neighbour) && distance[neighbour] != UNREACHABLE && distance[neighbour] + 1 < distance[current]) {
+                distance[current] = distance[neighbour] + 1;
+            }
+        }
+
+        if (distance[current] != UNREACHABLE) {
+            queue.push_back(current);
+        }
+    }
+    propagate();
+}
+
+void FlowField::update()
+{
+    PROFILE_ZONE("FlowField::update");
+    if (goal < 0) {
+        return;
+    }
+
+    bool isLogComplete = mapVersion >= map->typeChangesStart && mapVersion <= map->typeVersion;
+    if (distance.size() != map->tileCount() || !isLogComplete) {
+        rebuild();
+        return;
+    }
+
+    for (int version = mapVersion; version < map->typeVersion; version++) {
+        int tile = map->typeChanges[version - map->typeChangesStart];
+        bool isNowWalkable = isWalkable(tile);
+        if (tile == goal || isNowWalkable == (bool)walkable[tile]) {
+            continue; // upgrading the castle or building on sea doesn't change the field
+        }
+
+        walkable[tile] = isNowWalkable;
+        if (isNowWalkable) {
+            openTile(tile);
+        } else {
+            closeTile(tile);
+        }
+    }
+    mapVersion = map->typeVersion;
+    map->forgetTypeChanges(mapVersion); // the castle field is the only reader of the log
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <climits>
+#include <cstdint>
+
+#include "../map/map.h"
+
+// number of steps from every tile to one goal tile (the castle), so a unit only has to look at its neighbours
+// built once with a breadth first search and after that repaired locally for every tile in Map::typeChanges, which it trims after reading
+// occupancy is not part of the field, units skip neighbours that are taken when they pick their step
+class FlowField
+{
+private:
+    Map *map;
+    int goal;
+    int mapVersion; // map->typeVersion the field is up to date with
+
+    std::vector<int> distance;
+    std::vector<uint8_t> walkable;
+
+    // reused between updates
+    std::vector<int> queue;
+    std::vector<std::pair<int, int>> raised; // tile and the distance it had before it was cut off
+
+    bool isWalkable(int tile);
+    bool canStepFrom(int tile) { return tile == goal || walkable[tile]; }
+    void rebuild();
+    void openTile(int tile);
+    void closeTile(int tile);
+    void propagate(); // relaxes outwards from the tiles in queue
+public:
+    static const int UNREACHABLE = INT_MAX;
+
+    void setGoal(int tile);
+    int getGoal() { return goal; }
+    void update(); // applies the tile type changes since the last update
+    int getDistance(int tile) { return distance[tile]; }
+
+    FlowField(Map *setMap = NULL);
+    ~FlowField();
+};
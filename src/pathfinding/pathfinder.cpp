@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "pathfinder.h"
+#include "../profiler/profiler.h"
+
+Pathfinder::Pathfinder(Map *setMap, OccupancyGrid *setOccupancy)
+{
+    map = setMap;
+    occupancy = setOccupancy;
+    searchStamp = 0;
+    cacheMapVersion = -1;
+    maxCacheSize = 4096;
+    queriesThisTick = 0;
+    maxQueriesPerTick = 32;
+    occupiedCost = 3;
+}
+
+Pathfinder::~Pathfinder()
+{
+    map = NULL;
+    occupancy = NULL;
+}
+
+void Pathfinder::resize()
+{
+    int tileCount = map->tileCount();
+    if (costSoFar.size() != tileCount) {
+        costSoFar.assign(tileCount, 0);
+        cameFrom.assign(tileCount, -1);
+        openStamp.assign(tileCount, 0);
+        closedStamp.assign(tileCount, 0);
+        searchStamp = 0;
+        open.reserve(tileCount);
+    }
+}
+
+void Pathfinder::beginTick()
+{
+    queriesThisTick = 0;
+}
+
+bool Pathfinder::hasBudget()
+{
+    return queriesThisTick < maxQueriesPerTick;
+}
+
+void Pathfinder::clearCache()
+{
+    cache.clear();
+}
+
+int Pathfinder::distance(int from, int to)
+{
+    // the map is an "even-q" offset layout (even columns sit half a tile lower), convert to axial coordinates
+    int fromX = from / map->cols;
+    int fromY = from % map->cols;
+    int toX = to / map->cols;
+    int toY = to % map->cols;
+
+    int fromR = fromY - (fromX + (fromX & 1)) / 2;
+    int toR = toY - (toX + (toX & 1)) / 2;
+
+    int dq = toX - fromX;
+    int dr = toR - fromR;
+    return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+}
+
+float Pathfinder::stepCost(int tile, int goal)
+{
+    // same rules as UnitWorld::canEnter, except that the goal may be locked (the castle)
+    int x = tile / map->cols;
+    int y = tile % map->cols;
+    if (x < 1 || x > map->rows - 2 || y < 1 || y > map->cols - 2) {
+        return -1;
+    }
+
+    Tile &target = map->tileAtIndex(tile);
+    if (tile != goal && isTileTypeLocked(target.getType())) {
+        return -1;
+    }
+
+    if (occupancy != NULL && (occupancy->isOccupied(tile) || occupancy->isBlocked(tile))) {
+        return 1 + occupiedCost;
+    }
+    return 1;
+}
+
+bool Pathfinder::search(int start, int goal, std::vector<int> &path)
+{
+    resize();
+
+    searchStamp++;
+    if (searchStamp == 0) { // wrapped around, old stamps could match again
+        std::fill(openStamp.begin(), openStamp.end(), 0);
+        std::fill(closedStamp.begin(), closedStamp.end(), 0);
+        searchStamp = 1;
+    }
+
+    open.clear();
+    costSoFar[start] = 0;
+    cameFrom[start] = -1;
+    openStamp[start] = searchStamp;
+    open.push_back({(float)distance(start, goal), start});
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end());
+        int current = open.back().tile;
+        open.pop_back();
+
+        if (closedStamp[current] == searchStamp) { // an older, more expensive entry of a tile that was already expanded
+            continue;
+        }
+        closedStamp[current] = searchStamp;
+
+        if (current == goal) {
+            path.clear();
+            for (int tile = goal; tile != -1; tile = cameFrom[tile]) {
+                path.push_back(tile);
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        int x = current / map->cols;
+        int y = current % map->cols;
+        for (int direction=0; direction < 6; direction++) {
+            int neighbourX, neighbourY;
+            Map::getNeighbour(x, y, direction, neighbourX, neighbourY);
+            if (!map->isInside(neighbourX, neighbourY)) {
+                continue;
+            }
+
+            int neighbour = map->tileIndex(neighbourX, neighbourY);
+            if (closedStamp[neighbour] == searchStamp) {
+                continue;
+            }
+
+            float cost = stepCost(neighbour, goal);
+            if (cost < 0) {
+                continue;
+            }
+
+            float newCost = costSoFar[current] + cost;
+            if (openStamp[neighbour] != searchStamp || newCost < costSoFar[neighbour]) {
+                openStamp[neighbour] = searchStamp;
+                costSoFar[neighbour] = newCost;
+                cameFrom[neighbour] = current;
+                open.push_back({newCost + distance(neighbour, goal), neighbour});
+                std::push_heap(open.begin(), open.end());
+            }
+        }
+    }
+
+    return false;
+}
+
+const std::vector<int>* Pathfinder::getCachedPath(int start, int goal)
+{
+    if (cacheMapVersion != map->typeVersion) {
+        cache.clear();
+        cacheMapVersion = map->typeVersion;
+    }
+
+    uint64_t key = ((uint64_t)start << 32) | (uint32_t)goal;
+    std::unordered_map<uint64_t, std::vector<int>>::iterator found = cache.find(key);
+    if (found == cache.end()) {
+        return NULL;
+    }
+    return &found->second;
+}
+
+const std::vector<int>* Pathfinder::findPath(int start, int goal)
+{
+    PROFILE_ZONE("Pathfinder::findPath");
+    const std::vector<int> *cached = getCachedPath(start, goal);
+    if (cached != NULL) {
+        return cached->empty() ? NULL : cached;
+    }
+
+    if (!hasBudget()) {
+        return NULL;
+    }
+    queriesThisTick++;
+
+    if (cache.size() >= maxCacheSize) {
+        cache.clear();
+    }
+
+    // failed searches are cached as an empty path so an unreachable goal is not searched again every tick
+    uint64_t key = ((uint64_t)start << 32) | (uint32_t)goal;
+    std::vector<int> &path = cache[key];
+    if (!search(start, goal, path)) {
+        path.clear();
+        return NULL;
+    }
+    return &path;
+}
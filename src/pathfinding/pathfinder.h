@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "../map/map.h"
+#include "../units/occupancyGrid.h"
+
+// A* over the hex grid of the map, positions are tile indices (Map::tileIndex)
+// the search buffers are kept between queries, found paths are cached until a tile type changes
+// and the number of searches per tick is limited, callers get NULL back when the budget is used up
+class Pathfinder
+{
+private:
+    Map *map;
+    OccupancyGrid *occupancy;
+
+    // per tile search state, a tile only counts as touched when its stamp equals searchStamp
+    std::vector<float> costSoFar;
+    std::vector<int> cameFrom;
+    std::vector<uint32_t> openStamp;
+    std::vector<uint32_t> closedStamp;
+    uint32_t searchStamp;
+
+    struct OpenNode
+    {
+        float priority;
+        int tile;
+        bool operator<(const OpenNode &other) const { return priority > other.priority; } // std heap is a max heap
+    };
+    std::vector<OpenNode> open;
+
+    std::unordered_map<uint64_t, std::vector<int>> cache;
+    int cacheMapVersion;
+    int maxCacheSize;
+
+    int queriesThisTick;
+
+    void resize();
+    float stepCost(int tile, int goal);
+    int distance(int from, int to);
+    bool search(int start, int goal, std::vector<int> &path);
+public:
+    int maxQueriesPerTick;
+    float occupiedCost; // extra cost of walking through a tile that has a unit on it
+
+    void beginTick(); // resets the query budget, call once per simulation tick
+    bool hasBudget();
+    const std::vector<int>* findPath(int start, int goal); // start to goal inclusive, NULL when there is no path or no budget left
+    const std::vector<int>* getCachedPath(int start, int goal); // never searches, NULL when not cached
+    void clearCache();
+
+    Pathfinder(Map *setMap = NULL, OccupancyGrid *setOccupancy = NULL);
+    ~Pathfinder();
+};
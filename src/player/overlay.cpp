@@ -1,10 +1,12 @@
+#include <algorithm>
+
 #include "overlay.h"
 
-Overlay::Overlay(int screenWidth_, int screenHeight_, std::map<std::string, Texture2D> tileTextures_) 
+Overlay::Overlay(int screenWidth_, int screenHeight_, TextureRegistry *textures_) 
 {
     screenWidth = screenWidth_;
     screenHeight = screenHeight_;
-    tileTextures = tileTextures_;
+    textures = textures_;
 
     inventoryPos = { screenWidth/4.0f*3.0f, 0};
     inventoryWidth = screenWidth/4.0f;
@@ -33,20 +35,25 @@ Overlay::Overlay(int screenWidth_, int screenHeight_, std::map<std::string, Text
         }
     };
     
-    buildTileNames = {
-        "food",
-        "coral",
-        "training"
+    buildTileTypes = {
+        TILE_FOOD,
+        TILE_CORAL,
+        TILE_TRAINING
     };
 
+    for (int i = 0; i < buildTileTypes.size(); i++) {
+        buildTileTextures.push_back(textures != NULL ? textures->getHandle(tileTypeName(buildTileTypes[i])) : NO_TEXTURE);
+    }
+
     coralTileCost = 0;
     foodTileCost = 0;
     trainingTileCost = 0;
 
     selectedBuildTile = -1;
-    highlightTileTexture = LoadTexture("sprites/UI-elements/hexHighlight.png");
+    highlightTileTexture = textures != NULL ? textures->getHandle("hexHighlight") : NO_TEXTURE;
 
     isBuildMode = true;
+    isProfilerShown = false;
 }
 
 Overlay::~Overlay() 
@@ -65,7 +72,8 @@ void Overlay::drawBuildMode()
     DrawRectangle(buildMenuPos.x, buildMenuPos.y, buildMenuWidth, buildMenuHeight, BROWN);
 
     for(int i = 0; i < buildTilePositions.size(); i++) {
-        DrawTextureEx(tileTextures[buildTileNames[i]], buildTilePositions[i], 0, (double) buildTileSize / 810, WHITE);
+        Texture2D &sprite = textures->get(buildTileTextures[i]);
+        DrawTextureEx(sprite, buildTilePositions[i], 0, (double) buildTileSize / sprite.height, WHITE);
     }
 
     const char*text0 = TextFormat("%d coral", foodTileCost);
@@ -96,7 +104,8 @@ void Overlay::drawBuildMode()
     DrawTextEx(font, text2, position2, fontSize, spacing, DARKGRAY);
 
     if(selectedBuildTile > -1 && selectedBuildTile < buildTilePositions.size()) {
-        DrawTextureEx(highlightTileTexture, buildTilePositions[selectedBuildTile], 0, (double) buildTileSize / 810, WHITE);
+        Texture2D &highlight = textures->get(highlightTileTexture);
+        DrawTextureEx(highlight, buildTilePositions[selectedBuildTile], 0, (double) buildTileSize / highlight.height, WHITE);
     }
 
 }
@@ -227,11 +236,11 @@ void Overlay::drawTrainingMenu(int level)
 
 }
 
-int Overlay::mouseOnBuildTile() 
+int Overlay::mouseOnBuildTile(Vector2 mousePos) 
 {
     for(int i = 0; i < buildTilePositions.size(); i++) {
         Rectangle buildTileRect = { buildTilePositions[i].x, buildTilePositions[i].y, buildTileSize*1.15f, (float)buildTileSize };
-        if (CheckCollisionPointRec(GetMousePosition(), buildTileRect)) {
+        if (CheckCollisionPointRec(mousePos, buildTileRect)) {
             return i;
         }
     }
@@ -247,12 +256,12 @@ void Overlay::selectBuildTile(int buildTile)
     selectedBuildTile = buildTile;
 }
 
-std::string Overlay::getBuildTileName() 
+TileType Overlay::getBuildTileType() 
 {
-    if(selectedBuildTile < 0 || selectedBuildTile >= buildTileNames.size()) {
-        return "";
+    if(selectedBuildTile < 0 || selectedBuildTile >= buildTileTypes.size()) {
+        return TILE_NONE;
     }
-    return buildTileNames[selectedBuildTile];
+    return buildTileTypes[selectedBuildTile];
 }
 
 void Overlay::updateCooldown(double dt)
@@ -263,9 +272,8 @@ void Overlay::updateCooldown(double dt)
 }
 
 
-bool Overlay::isMouseOnOverlay() 
+bool Overlay::isMouseOnOverlay(Vector2 mousePos) 
 {
-    Vector2 mousePos = GetMousePosition();
     bool isXInBuildMenu = (mousePos.x > buildMenuPos.x && mousePos.x < buildMenuPos.x + buildMenuWidth);
     bool isYInBuildMenu = (mousePos.y > buildMenuPos.y && mousePos.y < buildMenuPos.y + buildMenuHeight);
     if(isBuildMode && isXInBuildMenu && isYInBuildMenu) {
@@ -285,4 +293,39 @@ void Overlay::setTileTypeCosts(int foodCost, int coralCost, int trainingCost)
     foodTileCost = foodCost;
     coralTileCost = coralCost;
     trainingTileCost = trainingCost;
-}
\ No newline at end of file
+}
+
+void Overlay::drawProfiler(Profiler *profiler)
+{
+    int frameCount = profiler->getFrameCount();
+    int zoneCount = profiler->getZoneCount();
+    int barWidth = 2;
+    int graphHeight = 200;
+    double pixelsPerMs = graphHeight / 50.0; // 50ms fills the graph
+    Vector2 position = { 10, 10 };
+    int graphWidth = Profiler::frameHistory * barWidth;
+
+    DrawRectangle(position.x, position.y, graphWidth, graphHeight + 20 + zoneCount * 12, (Color){ 0, 0, 0, 180 });
+
+    // newest frame on the right, red when it missed 60 fps
+    for (int age=0; age < frameCount; age++) {
+        double frameTime = profiler->getFrameTime(age);
+        int height = std::min((int)(frameTime * pixelsPerMs), graphHeight);
+        int x = position.x + graphWidth - (age + 1) * barWidth;
+        DrawRectangle(x, position.y + graphHeight - height, barWidth, height, frameTime > 1000.0 / 60.0 ? RED : GREEN);
+    }
+    int targetY = position.y + graphHeight - 1000.0 / 60.0 * pixelsPerMs;
+    DrawLine(position.x, targetY, position.x + graphWidth, targetY, YELLOW);
+
+    for (int zone=0; zone < zoneCount; zone++) {
+        double total = 0;
+        double max = 0;
+        for (int age=0; age < frameCount; age++) {
+            double time = profiler->getZoneTime(age, zone);
+            total += time;
+            max = std::max(max, time);
+        }
+        double average = frameCount > 0 ? total / frameCount : 0;
+        DrawText(TextFormat("%s  avg %.2f ms  max %.2f ms", profiler->getZoneName(zone).c_str(), average, max), position.x + 5, position.y + graphHeight + 10 + zone * 12, 10, WHITE);
+    }
+}
@@ -5,6 +5,9 @@
 #include <iostream>
 #include <cmath>
 #include "../raylib.h"
+#include "../textures/textureRegistry.h"
+#include "../map/tileType.h"
+#include "../profiler/profiler.h"
 
 class Overlay
 {
@@ -23,24 +26,27 @@ private:
     int foodTileCost, coralTileCost, trainingTileCost;
 
     
-    std::vector<std::string> buildTileNames;
-    Texture2D highlightTileTexture;
+    std::vector<TileType> buildTileTypes;
+    TextureHandle highlightTileTexture;
 
-    std::map<std::string, Texture2D> tileTextures;
+    TextureRegistry *textures;
+    std::vector<TextureHandle> buildTileTextures;
 public:
     double trainingCooldown;
     int selectedBuildTile;
     bool isBuildMode;
+    bool isProfilerShown; // F3, only in a PROFILE=1 build
     void drawBuildMode();
     void drawInventory(int food, int coral, int score, int time, int wave, int nextWaveTime);
     void drawCastleMenu(int level);
     void drawTrainingMenu(int level);
-    bool isMouseOnOverlay();
-    int mouseOnBuildTile();
+    void drawProfiler(Profiler *profiler); // frame time graph and the average/max of every zone
+    bool isMouseOnOverlay(Vector2 mousePos);
+    int mouseOnBuildTile(Vector2 mousePos);
     void selectBuildTile(int buildTile);
-    std::string getBuildTileName();
+    TileType getBuildTileType(); // TILE_NONE when nothing is selected
     void setTileTypeCosts(int foodCost, int coralCost, int trainingCost);
     void updateCooldown(double dt);
-    Overlay(int screenWidth = 1920, int screenHeight = 1084, std::map<std::string, Texture2D> tileTextures_ = std::map<std::string, Texture2D>());
+    Overlay(int screenWidth = 1920, int screenHeight = 1084, TextureRegistry *textures_ = NULL);
     ~Overlay();
 };
\ No newline at end of file
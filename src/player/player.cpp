@@ -2,7 +2,7 @@
 
 #include "player.h"
 
-Player::Player(Vector2 startPosition, int setScreenWidth, int setScreenHeight, Map *setMap, Texture2D *setTileHighLite, std::map<std::string, Texture2D> setUnitTextures)
+Player::Player(Vector2 startPosition, int setScreenWidth, int setScreenHeight, Map *setMap, Texture2D *setTileHighLite, TextureRegistry *setTextures, UnitWorld *setWorld)
 {
     food = 0;
     coral = 0;
@@ -12,7 +12,7 @@ Player::Player(Vector2 startPosition, int setScreenWidth, int setScreenHeight, M
 
     map = setMap;
 
-    unitTextures = setUnitTextures;
+    textures = setTextures;
     tileHighLite = setTileHighLite;
 
     position = startPosition;
@@ -20,7 +20,7 @@ Player::Player(Vector2 startPosition, int setScreenWidth, int setScreenHeight, M
     camera.rotation = 0.0f;
     camera.zoom = 3.0f;
 
-    playerUnits = UnitInventory("player", map, &camera, setTileHighLite, setUnitTextures);
+    playerUnits = UnitInventory(OWNER_PLAYER, map, setWorld, setTextures);
 
     castleCost = 50;
     castleLvl = 1;
@@ -43,34 +43,34 @@ Player::~Player()
     map = NULL;
 }
 
-void Player::movement(double dt, int isBuildMode)
+void Player::movement(double dt, int isBuildMode, Input *input)
 {
-    if (IsKeyDown(KEY_W))
+    if (input->isKeyDown(KEY_W))
     {
         camera.target.y -= movementSpeed * dt / camera.zoom;
-    } else if (IsKeyDown(KEY_UP)) {
+    } else if (input->isKeyDown(KEY_UP)) {
         camera.target.y -= movementSpeed * dt / camera.zoom;
     }
-    if (IsKeyDown(KEY_S))
+    if (input->isKeyDown(KEY_S))
     {
         camera.target.y += movementSpeed * dt / camera.zoom;
-    } else if (IsKeyDown(KEY_DOWN)) {
+    } else if (input->isKeyDown(KEY_DOWN)) {
         camera.target.y += movementSpeed * dt / camera.zoom;
     }
-    if (IsKeyDown(KEY_A))
+    if (input->isKeyDown(KEY_A))
     {
         camera.target.x -= movementSpeed * dt / camera.zoom;
-    } else if (IsKeyDown(KEY_LEFT)) {
+    } else if (input->isKeyDown(KEY_LEFT)) {
         camera.target.x -= movementSpeed * dt / camera.zoom;
     }
-    if (IsKeyDown(KEY_D))
+    if (input->isKeyDown(KEY_D))
     {
         camera.target.x += movementSpeed * dt / camera.zoom;
-    } else if (IsKeyDown(KEY_RIGHT)) {
+    } else if (input->isKeyDown(KEY_RIGHT)) {
         camera.target.x += movementSpeed * dt / camera.zoom;
     }
 
-    if (GetMouseWheelMove() > 0) 
+    if (input->getMouseWheelMove() > 0) 
     {
         double zoomBefore = camera.zoom;
         camera.zoom += zoomSpeed * dt / camera.zoom;
@@ -78,7 +78,7 @@ void Player::movement(double dt, int isBuildMode)
             camera.zoom = maxZoom;
         }
     }
-    else if (GetMouseWheelMove() < 0)
+    else if (input->getMouseWheelMove() < 0)
     {
         camera.zoom -= zoomSpeed * dt / camera.zoom;
         if (camera.zoom < minZoom) {
@@ -88,20 +88,20 @@ void Player::movement(double dt, int isBuildMode)
 
 
     if (isBuildMode == -1) {
-        if (IsMouseButtonPressed(0)) // for camera movement by dragging of the mouse whilst pressing left mouse button
+        if (input->isMouseButtonPressed(0)) // for camera movement by dragging of the mouse whilst pressing left mouse button
         {
-            mouseStartPos = GetMousePosition();
+            mouseStartPos = input->getMousePosition();
         }
 
-        if (IsMouseButtonDown(0)) 
+        if (input->isMouseButtonDown(0)) 
         {
-            Vector2 currentMousePos = GetMousePosition();
+            Vector2 currentMousePos = input->getMousePosition();
             if (currentMousePos.x != mouseStartPos.x || currentMousePos.y != mouseStartPos.y) {
                 camera.target.x -= (currentMousePos.x-mouseStartPos.x) * mouseMovementSpeed * dt / camera.zoom;
                 camera.target.y -= (currentMousePos.y-mouseStartPos.y) * mouseMovementSpeed * dt / camera.zoom;
             }
             
-            mouseStartPos = GetMousePosition();
+            mouseStartPos = input->getMousePosition();
         }
     }
 }
@@ -122,15 +122,15 @@ int Player::getCoralAmount() {
     return coral;
 }
 
-int Player::getTileCost(std::string type) {
+int Player::getTileCost(TileType type) {
     int tileCount = map->countTilesWithType(type);
-    if(tileCount == 0 && type == "coral") return 0; // fist coral is always free
-    if(type != "coral") tileCount++;
+    if(tileCount == 0 && type == TILE_CORAL) return 0; // fist coral is always free
+    if(type != TILE_CORAL) tileCount++;
     int cost = (int) std::pow(1.6, tileCount);
     return cost;
 }
 
-bool Player::buyTile(std::string type) {
+bool Player::buyTile(TileType type) {
     int cost = getTileCost(type);
     if (cost > coral) return false;
     
@@ -154,23 +154,25 @@ int Player::getCastleLvl() {
     return castleLvl;
 }
 
-void Player::Update(double dt, int isBuildMode, bool overlay) {
-    playerUnits.Update(dt, overlay);
-    movement(dt, isBuildMode);
-
-    if (GetTime() - (int)GetTime() + dt > 1 && (int)GetTime() % productionSpeed == 0) {
-        int foodTileCount = map->countTilesWithType("food");
-        int coralTileCount = map->countTilesWithType("coral");
-        addFoodAmount(foodTileCount); // 1 / tile / prodSpeed
-        addCoralAmount(coralTileCount); // 1 / tile / prodSpeed
-    }
+void Player::Update(double dt, int isBuildMode, Input *input) {
+    playerUnits.Update(dt);
+    movement(dt, isBuildMode, input);
+}
 
+void Player::produce() {
+    int foodTileCount = map->countTilesWithType(TILE_FOOD);
+    int coralTileCount = map->countTilesWithType(TILE_CORAL);
+    addFoodAmount(foodTileCount); // 1 / tile / prodSpeed
+    addCoralAmount(coralTileCount); // 1 / tile / prodSpeed
+}
 
+int Player::getProductionSpeed() {
+    return productionSpeed;
 }
 
-void Player::Render() {
+void Player::Render(double alpha) {
     DrawText(TextFormat("Hp: %d", int(castleHealth)), castlePos.x + 0.5 * map->getTile({0,0})->width, castlePos.y + 0.75 * map->getTile({0,0})->height, 10, WHITE);
-    playerUnits.Render();
+    playerUnits.Render(alpha);
 }
 
 void Player::Start(Vector2 center) {
@@ -179,4 +181,25 @@ void Player::Start(Vector2 center) {
     camera.zoom = 3.0;
 
     castlePos = map->gridPosToWorldPos(center);
-}
\ No newline at end of file
+}
+
+void Player::saveState(SnapshotWriter &writer)
+{
+    writer.write(food);
+    writer.write(coral);
+    writer.write(castleLvl);
+    writer.write(castleCost);
+    writer.write(castleHealth);
+    writer.write(productionSpeed);
+}
+
+bool Player::loadState(SnapshotReader &reader)
+{
+    reader.read(food);
+    reader.read(coral);
+    reader.read(castleLvl);
+    reader.read(castleCost);
+    reader.read(castleHealth);
+    reader.read(productionSpeed);
+    return !reader.hasFailed();
+}
@@ -2,8 +2,10 @@
 #include <string>
 #include "../raylib.h"
 #include "../map/map.h"
-#include "../units/unit.h"
+#include "../units/unitWorld.h"
 #include "../units/unitInventory.h"
+#include "../input/input.h"
+#include "../save/snapshot.h"
 
 class Player
 {
@@ -29,7 +31,7 @@ private:
 
     Map *map;
 
-    std::map<std::string, Texture2D> unitTextures;
+    TextureRegistry *textures;
     Texture2D *tileHighLite;
     int productionSpeed;
 public:
@@ -41,18 +43,22 @@ public:
     Vector2 position;
     void addFoodAmount(int amount); // remove food if buying something add food when receiving something
     void addCoralAmount(int amount); // remove coral if buying something add coral when receiving something
-    void movement(double dt, int isBuildMode);
+    void movement(double dt, int isBuildMode, Input *input);
     int getFoodAmount();
     int getCoralAmount();
-    int getTileCost(std::string type);
-    bool buyTile(std::string type);
+    int getTileCost(TileType type);
+    bool buyTile(TileType type);
     bool buyCastleUpgrade();
     int getCastleLvl();
+    void saveState(SnapshotWriter &writer); // resources and castle, the units are saved with the UnitWorld
+    bool loadState(SnapshotReader &reader);
 
-    void Update(double dt, int isBuildMode, bool overlay);
-    void Render();
+    void Update(double dt, int isBuildMode, Input *input);
+    void produce(); // 1 food per food tile and 1 coral per coral tile, the game schedules it every productionSpeed seconds
+    int getProductionSpeed();
+    void Render(double alpha);
     void Start(Vector2 center);
 
-    Player(Vector2 startPosition={0,0}, int screenWidth=1920, int screenHeight=1080, Map *setMap = NULL, Texture2D *setTileHighLite = NULL, std::map<std::string, Texture2D> setUnitTextures = {});
+    Player(Vector2 startPosition={0,0}, int screenWidth=1920, int screenHeight=1080, Map *setMap = NULL, Texture2D *setTileHighLite = NULL, TextureRegistry *setTextures = NULL, UnitWorld *setWorld = NULL);
     ~Player();
 };
\ No newline at end of file
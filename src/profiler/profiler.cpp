@@ -0,0 +1,187 @@
+#include <cstdio>
+#include <algorithm>
+
+#include "profiler.h"
+
+Profiler profiler;
+
+const int Profiler::frameHistory;
+const int Profiler::maxZones;
+const int Profiler::maxEvents;
+
+Profiler::Profiler()
+{
+    startTime = std::chrono::steady_clock::now();
+    frameStart = startTime;
+    currentFrame = 0;
+    frameCount = 0;
+    nextEvent = 0;
+    eventCount = 0;
+}
+
+Profiler::~Profiler()
+{
+}
+
+int64_t Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+int Profiler::registerZone(const char *name)
+{
+    for (int i=0; i < zoneNames.size(); i++) {
+        if (zoneNames[i] == name) {
+            return i;
+        }
+    }
+    if (zoneNames.size() >= maxZones) {
+        return -1; // its samples are dropped
+    }
+
+    if (frameTimes.empty()) {
+        frameTimes.assign(frameHistory, 0);
+        zoneTimes.assign(frameHistory * maxZones, 0);
+        frameNumbers.assign(frameHistory, 0);
+        zoneTotals.assign(maxZones, 0);
+        zoneCalls.assign(maxZones, 0);
+        events.resize(maxEvents);
+    }
+
+    zoneNames.push_back(name);
+    return zoneNames.size() - 1;
+}
+
+void Profiler::addSample(int zone, int64_t start, int64_t end)
+{
+    if (zone < 0) {
+        return;
+    }
+
+    double time = (end - start) / 1000.0;
+    zoneTimes[currentFrame * maxZones + zone] += time;
+    zoneTotals[zone] += time;
+    zoneCalls[zone]++;
+
+    events[nextEvent] = {zone, start, end - start};
+    nextEvent = (nextEvent + 1) % maxEvents;
+    if (eventCount < maxEvents) {
+        eventCount++;
+    }
+}
+
+void Profiler::endFrame()
+{
+    std::chrono::steady_clock::time_point frameEnd = std::chrono::steady_clock::now();
+    if (!frameTimes.empty()) {
+        frameTimes[currentFrame] = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+        frameNumbers[currentFrame] = frameCount;
+        currentFrame = (currentFrame + 1) % frameHistory;
+        for (int i=0; i < maxZones; i++) {
+            zoneTimes[currentFrame * maxZones + i] = 0;
+        }
+    }
+    frameCount++;
+    frameStart = frameEnd;
+}
+
+void Profiler::reset()
+{
+    std::fill(frameTimes.begin(), frameTimes.end(), 0);
+    std::fill(zoneTimes.begin(), zoneTimes.end(), 0);
+    std::fill(frameNumbers.begin(), frameNumbers.end(), 0);
+    std::fill(zoneTotals.begin(), zoneTotals.end(), 0);
+    std::fill(zoneCalls.begin(), zoneCalls.end(), 0);
+    currentFrame = 0;
+    frameCount = 0;
+    nextEvent = 0;
+    eventCount = 0;
+    frameStart = std::chrono::steady_clock::now();
+}
+
+int Profiler::getZoneCount()
+{
+    return zoneNames.size();
+}
+
+const std::string& Profiler::getZoneName(int zone)
+{
+    return zoneNames[zone];
+}
+
+int Profiler::getFrameCount()
+{
+    if (frameTimes.empty()) {
+        return 0;
+    }
+    return frameCount < frameHistory - 1 ? frameCount : frameHistory - 1; // the last slot is the frame being filled
+}
+
+double Profiler::getFrameTime(int age)
+{
+    int frame = (currentFrame - 1 - age + 2 * frameHistory) % frameHistory;
+    return frameTimes[frame];
+}
+
+double Profiler::getZoneTime(int age, int zone)
+{
+    int frame = (currentFrame - 1 - age + 2 * frameHistory) % frameHistory;
+    return zoneTimes[frame * maxZones + zone];
+}
+
+double Profiler::getZoneTotal(int zone)
+{
+    return zoneTotals[zone];
+}
+
+int64_t Profiler::getZoneCalls(int zone)
+{
+    return zoneCalls[zone];
+}
+
+bool Profiler::writeCsv(std::string fileName)
+{
+    FILE *file = fopen(fileName.c_str(), "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    fprintf(file, "frame,total");
+    for (int i=0; i < zoneNames.size(); i++) {
+        fprintf(file, ",%s", zoneNames[i].c_str());
+    }
+    fprintf(file, "\n");
+
+    for (int age = getFrameCount() - 1; age >= 0; age--) {
+        int frame = (currentFrame - 1 - age + 2 * frameHistory) % frameHistory;
+        fprintf(file, "%lld,%.4f", (long long)frameNumbers[frame], frameTimes[frame]);
+        for (int i=0; i < zoneNames.size(); i++) {
+            fprintf(file, ",%.4f", zoneTimes[frame * maxZones + i]);
+        }
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    return true;
+}
+
+bool Profiler::writeChromeTrace(std::string fileName)
+{
+    FILE *file = fopen(fileName.c_str(), "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    // complete events ("ph":"X"), oldest first
+    fprintf(file, "{\"traceEvents\":[\n");
+    int first = (nextEvent - eventCount + maxEvents) % maxEvents;
+    for (int i=0; i < eventCount; i++) {
+        ProfileEvent &event = events[(first + i) % maxEvents];
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":0,\"tid\":0}%s\n",
+                zoneNames[event.zone].c_str(), (long long)event.start, (long long)event.duration, i + 1 < eventCount ? "," : "");
+    }
+    fprintf(file, "]}\n");
+
+    fclose(file);
+    return true;
+}
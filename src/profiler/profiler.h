@@ -0,0 +1,94 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// scoped timing zones, only compiled in with make PROFILE=1 (-DPROFILING), otherwise the macros are empty
+//
+//   void Map::draw(Camera2D camera)
+//   {
+//       PROFILE_ZONE("Map::draw");
+//       ...
+//
+// zones are inclusive (a zone inside another one is counted in both) and are meant for the main thread
+#ifdef PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) \
+    static const int PROFILE_CONCAT(profileZoneId, __LINE__) = profiler.registerZone(name); \
+    ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(PROFILE_CONCAT(profileZoneId, __LINE__))
+#define PROFILE_FRAME() profiler.endFrame()
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FRAME()
+#endif
+
+struct ProfileEvent
+{
+    int zone;
+    int64_t start; // microseconds since the profiler was created
+    int64_t duration;
+};
+
+// keeps the time per zone of the last frameHistory frames and the last maxEvents single zone runs
+// the frames feed the graph in the Overlay, the events the chrome trace (chrome://tracing, ui.perfetto.dev)
+class Profiler
+{
+private:
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point frameStart;
+
+    std::vector<std::string> zoneNames;
+
+    // ring buffers, allocated when the first zone registers so an unused profiler costs nothing
+    std::vector<double> frameTimes; // milliseconds, frameHistory entries
+    std::vector<double> zoneTimes; // milliseconds, frameHistory * maxZones entries
+    std::vector<int64_t> frameNumbers;
+    int currentFrame; // slot in the ring that is being filled
+    int64_t frameCount;
+
+    // since the last reset, for runs that are longer than the ring
+    std::vector<double> zoneTotals; // milliseconds
+    std::vector<int64_t> zoneCalls;
+
+    std::vector<ProfileEvent> events;
+    int nextEvent;
+    int eventCount;
+public:
+    static const int frameHistory = 240;
+    static const int maxZones = 32;
+    static const int maxEvents = 65536;
+
+    int64_t now(); // microseconds since the profiler was created
+    int registerZone(const char *name); // id for the zone, the same name gives the same id
+    void addSample(int zone, int64_t start, int64_t end);
+    void endFrame();
+    void reset(); // forget every frame, event and total, the zones stay registered
+
+    int getZoneCount();
+    const std::string& getZoneName(int zone);
+    int getFrameCount(); // finished frames in the ring, up to frameHistory - 1
+    double getFrameTime(int age); // age 0 is the last finished frame
+    double getZoneTime(int age, int zone);
+    double getZoneTotal(int zone);
+    int64_t getZoneCalls(int zone);
+
+    bool writeCsv(std::string fileName); // a row per frame: frame, total and every zone in milliseconds
+    bool writeChromeTrace(std::string fileName);
+
+    Profiler();
+    ~Profiler();
+};
+
+extern Profiler profiler;
+
+class ProfileZone
+{
+private:
+    int zone;
+    int64_t start;
+public:
+    ProfileZone(int setZone) { zone = setZone; start = profiler.now(); }
+    ~ProfileZone() { profiler.addSample(zone, start, profiler.now()); }
+};
@@ -0,0 +1,44 @@
+#include "random.h"
+
+Random::Random(uint64_t seed_, uint64_t stream)
+{
+    seed(seed_, stream);
+}
+
+void Random::seed(uint64_t seed, uint64_t stream)
+{
+    state = 0;
+    increment = (stream << 1) | 1;
+    next();
+    state += seed;
+    next();
+}
+
+uint32_t Random::next()
+{
+    uint64_t oldState = state;
+    state = oldState * 6364136223846793005ULL + increment;
+    uint32_t xorShifted = ((oldState >> 18) ^ oldState) >> 27;
+    uint32_t rotation = oldState >> 59;
+    return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+}
+
+int Random::nextInt(int bound)
+{
+    if (bound <= 0) {
+        return 0;
+    }
+    // numbers below threshold would make the low results a little more likely, throw them away
+    uint32_t threshold = (uint32_t)(-(uint32_t)bound) % (uint32_t)bound;
+    while (true) {
+        uint32_t value = next();
+        if (value >= threshold) {
+            return value % bound;
+        }
+    }
+}
+
+double Random::nextDouble()
+{
+    return next() * (1.0 / 4294967296.0);
+}
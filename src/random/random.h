@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+// small seeded generator (PCG32), every subsystem that needs random numbers owns one
+// so a match can be replayed from its seed and the subsystems don't change each other's numbers
+class Random
+{
+private:
+    uint64_t state;
+    uint64_t increment;
+public:
+    void seed(uint64_t seed, uint64_t stream = 0); // different streams with the same seed give unrelated numbers
+    uint32_t next();
+    int nextInt(int bound); // 0 to bound - 1 without modulo bias, 0 when bound <= 0
+    double nextDouble(); // 0 to 1, 1 excluded
+
+    Random(uint64_t seed_ = 0, uint64_t stream = 0);
+};
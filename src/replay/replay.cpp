@@ -0,0 +1,171 @@
+#include <cstring>
+
+#include "replay.h"
+
+static const char replayMagic[4] = {'S', 'F', 'R', 'P'};
+static const uint16_t replayVersion = 1;
+
+// records are written field by field so the file doesn't depend on struct padding
+static bool writeRecord(FILE *file, long tick, Command command)
+{
+    int32_t tick32 = tick;
+    uint8_t type = command.type;
+    int32_t x = command.x;
+    int32_t y = command.y;
+    int32_t value = command.value;
+    return fwrite(&tick32, sizeof(tick32), 1, file) == 1
+        && fwrite(&type, sizeof(type), 1, file) == 1
+        && fwrite(&x, sizeof(x), 1, file) == 1
+        && fwrite(&y, sizeof(y), 1, file) == 1
+        && fwrite(&value, sizeof(value), 1, file) == 1;
+}
+
+static bool readRecord(FILE *file, long &tick, Command &command)
+{
+    int32_t tick32, x, y, value;
+    uint8_t type;
+    bool isRead = fread(&tick32, sizeof(tick32), 1, file) == 1
+        && fread(&type, sizeof(type), 1, file) == 1
+        && fread(&x, sizeof(x), 1, file) == 1
+        && fread(&y, sizeof(y), 1, file) == 1
+        && fread(&value, sizeof(value), 1, file) == 1;
+    if (!isRead || type > COMMAND_END) {
+        return false;
+    }
+
+    tick = tick32;
+    command = {(CommandType)type, x, y, value};
+    return true;
+}
+
+ReplayRecorder::ReplayRecorder()
+{
+    file = NULL;
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+    if (file != NULL) {
+        fclose(file); // no end record, the replay just stops after the last command
+        file = NULL;
+    }
+}
+
+bool ReplayRecorder::open(std::string fileName, ReplayHeader header)
+{
+    if (file != NULL) {
+        fclose(file);
+    }
+
+    file = fopen(fileName.c_str(), "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    int32_t rows = header.rows;
+    int32_t cols = header.cols;
+    bool isWritten = fwrite(replayMagic, sizeof(replayMagic), 1, file) == 1
+        && fwrite(&replayVersion, sizeof(replayVersion), 1, file) == 1
+        && fwrite(&header.seed, sizeof(header.seed), 1, file) == 1
+        && fwrite(&header.tickRate, sizeof(header.tickRate), 1, file) == 1
+        && fwrite(&rows, sizeof(rows), 1, file) == 1
+        && fwrite(&cols, sizeof(cols), 1, file) == 1;
+    if (!isWritten) {
+        fclose(file);
+        file = NULL;
+    }
+    return isWritten;
+}
+
+void ReplayRecorder::record(long tick, Command command)
+{
+    if (file == NULL) {
+        return;
+    }
+    writeRecord(file, tick, command);
+}
+
+void ReplayRecorder::close(long tick)
+{
+    if (file == NULL) {
+        return;
+    }
+    writeRecord(file, tick, {COMMAND_END, 0, 0, 0});
+    fclose(file);
+    file = NULL;
+}
+
+ReplayPlayer::ReplayPlayer()
+{
+    header = {0, 60, 0, 0};
+    next = 0;
+    endTick = -1;
+    loaded = false;
+}
+
+ReplayPlayer::~ReplayPlayer()
+{
+}
+
+bool ReplayPlayer::open(std::string fileName)
+{
+    loaded = false;
+    ticks.clear();
+    commands.clear();
+    next = 0;
+    endTick = -1;
+
+    FILE *file = fopen(fileName.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    char magic[4];
+    uint16_t version;
+    int32_t rows, cols;
+    bool isRead = fread(magic, sizeof(magic), 1, file) == 1
+        && memcmp(magic, replayMagic, sizeof(magic)) == 0
+        && fread(&version, sizeof(version), 1, file) == 1
+        && version == replayVersion
+        && fread(&header.seed, sizeof(header.seed), 1, file) == 1
+        && fread(&header.tickRate, sizeof(header.tickRate), 1, file) == 1
+        && fread(&rows, sizeof(rows), 1, file) == 1
+        && fread(&cols, sizeof(cols), 1, file) == 1;
+    if (!isRead) {
+        fclose(file);
+        return false;
+    }
+    header.rows = rows;
+    header.cols = cols;
+
+    long tick;
+    Command command;
+    while (readRecord(file, tick, command)) {
+        if (command.type == COMMAND_END) {
+            endTick = tick;
+            break;
+        }
+        ticks.push_back(tick);
+        commands.push_back(command);
+    }
+    fclose(file);
+
+    loaded = true;
+    return true;
+}
+
+void ReplayPlayer::commandsAt(long tick, std::vector<Command> &result)
+{
+    while (next < commands.size() && ticks[next] < tick) { // can't happen in a file the recorder wrote
+        next++;
+    }
+    while (next < commands.size() && ticks[next] == tick) {
+        result.push_back(commands[next]);
+        next++;
+    }
+}
+
+bool ReplayPlayer::isFinished(long tick)
+{
+    return next >= commands.size() && (endTick == -1 || tick >= endTick);
+}
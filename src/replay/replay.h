@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// everything the player can do to the simulation, the game turns clicks and keys into these
+// so a match is fully described by its seed and the commands with the tick they happened on
+enum CommandType : uint8_t
+{
+    COMMAND_BUILD_TILE, // x, y, value is the TileType
+    COMMAND_TRAIN_UNIT, // x, y of the training tile, value is the unit level
+    COMMAND_UPGRADE_CASTLE,
+    COMMAND_UNIT_ORDER, // click on tile x, y for the player units: select, deselect, move or walk there
+    COMMAND_END // last record of a file, its tick is the length of the match
+};
+
+struct Command
+{
+    CommandType type;
+    int x;
+    int y;
+    int value;
+};
+
+struct ReplayHeader
+{
+    uint64_t seed;
+    double tickRate;
+    int rows;
+    int cols;
+};
+
+// writes the commands of a match to a small binary file:
+// "SFRP", version, header, then one fixed size record (tick, type, x, y, value) per command
+class ReplayRecorder
+{
+private:
+    FILE *file;
+public:
+    bool open(std::string fileName, ReplayHeader header);
+    void record(long tick, Command command);
+    void close(long tick); // writes the end record
+    bool isRecording() { return file != NULL; }
+
+    ReplayRecorder();
+    ~ReplayRecorder();
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+};
+
+// reads a whole recording and hands the commands back tick by tick
+class ReplayPlayer
+{
+private:
+    ReplayHeader header;
+    std::vector<long> ticks;
+    std::vector<Command> commands;
+    int next; // first command that was not handed out yet
+    long endTick;
+    bool loaded;
+public:
+    bool open(std::string fileName); // false when the file is missing, not a replay or from another version
+    bool isPlaying() { return loaded; }
+    ReplayHeader getHeader() { return header; }
+    void commandsAt(long tick, std::vector<Command> &result); // appends the commands of this tick
+    bool isFinished(long tick); // every command was played and the recorded match ended here
+
+    ReplayPlayer();
+    ~ReplayPlayer();
+};
@@ -0,0 +1,91 @@
+#include <cstdio>
+
+#include "snapshot.h"
+
+static const char snapshotMagic[4] = {'S', 'F', 'S', 'V'};
+
+const uint32_t SnapshotWriter::version;
+
+SnapshotWriter::SnapshotWriter()
+{
+    append(snapshotMagic, sizeof(snapshotMagic));
+    write(version);
+}
+
+void SnapshotWriter::append(const void *bytes, size_t size)
+{
+    const char *begin = (const char*)bytes;
+    data.insert(data.end(), begin, begin + size);
+}
+
+void SnapshotWriter::align()
+{
+    while (data.size() % 8 != 0) {
+        data.push_back(0);
+    }
+}
+
+bool SnapshotWriter::saveTo(std::string fileName)
+{
+    FILE *file = fopen(fileName.c_str(), "wb");
+    if (file == NULL) {
+        return false;
+    }
+    bool isWritten = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && isWritten;
+}
+
+SnapshotReader::SnapshotReader()
+{
+    position = 0;
+    failed = true; // until a file is loaded
+}
+
+bool SnapshotReader::loadFrom(std::string fileName)
+{
+    data.clear();
+    position = 0;
+    failed = true;
+
+    FILE *file = fopen(fileName.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size > 0) {
+        data.resize(size);
+        if (fread(data.data(), 1, size, file) != size) {
+            data.clear();
+        }
+    }
+    fclose(file);
+
+    failed = false;
+    char magic[4];
+    uint32_t fileVersion;
+    if (!take(magic, sizeof(magic)) || memcmp(magic, snapshotMagic, sizeof(magic)) != 0 || !read(fileVersion) || fileVersion != SnapshotWriter::version) {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotReader::take(void *bytes, size_t size)
+{
+    if (failed || size > data.size() - position) {
+        failed = true;
+        return false;
+    }
+    memcpy(bytes, data.data() + position, size);
+    position += size;
+    return true;
+}
+
+void SnapshotReader::align()
+{
+    while (position % 8 != 0 && position < data.size()) {
+        position++;
+    }
+}
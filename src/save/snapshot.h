@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+// binary snapshot of a running match, every part of the game writes its state with saveState(SnapshotWriter&)
+// and reads it back in the same order with loadState(SnapshotReader&)
+//
+// the file is "SFSV", the version and then plain values and arrays (a count followed by the raw elements),
+// every array starts on an 8 byte boundary so the file can be memory mapped and used in place.
+// loading reads the whole file in one go and copies each array with one memcpy, there is no parsing per field
+class SnapshotWriter
+{
+private:
+    std::vector<char> data;
+
+    void append(const void *bytes, size_t size);
+    void align();
+public:
+    static const uint32_t version = 2;
+
+    template<typename T> void write(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+        append(&value, sizeof(T));
+    }
+
+    template<typename T> void writeArray(const std::vector<T> &values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only arrays of plain values can be written");
+        uint64_t count = values.size();
+        write(count);
+        align();
+        if (count > 0) {
+            append(values.data(), count * sizeof(T));
+        }
+        align();
+    }
+
+    bool saveTo(std::string fileName);
+
+    SnapshotWriter();
+};
+
+class SnapshotReader
+{
+private:
+    std::vector<char> data;
+    size_t position;
+    bool failed;
+
+    bool take(void *bytes, size_t size);
+    void align();
+public:
+    bool loadFrom(std::string fileName); // false when the file is missing, not a snapshot or from another version
+
+    template<typename T> bool read(T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+        return take(&value, sizeof(T));
+    }
+
+    template<typename T> bool readArray(std::vector<T> &values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only arrays of plain values can be read");
+        uint64_t count;
+        if (!read(count)) {
+            return false;
+        }
+        align();
+        if (failed || count > (data.size() - position) / sizeof(T)) { // a broken count must not allocate gigabytes
+            failed = true;
+            return false;
+        }
+        values.resize(count);
+        if (count > 0) {
+            take(values.data(), count * sizeof(T));
+        }
+        align();
+        return !failed;
+    }
+
+    bool hasFailed() { return failed; } // a read ran past the end of the file, the game state is not usable
+
+    SnapshotReader();
+};
@@ -0,0 +1,56 @@
+#include <algorithm>
+
+#include "scheduler.h"
+
+Scheduler::Scheduler()
+{
+    nextOrder = 0;
+}
+
+void Scheduler::clear()
+{
+    queue.clear();
+    nextOrder = 0;
+}
+
+void Scheduler::schedule(int64_t tick, EventType type, int target)
+{
+    queue.push_back({tick, nextOrder, type, target});
+    nextOrder++;
+    std::push_heap(queue.begin(), queue.end(), Later());
+}
+
+bool Scheduler::popDue(int64_t tick, Event &event)
+{
+    if (queue.empty() || queue.front().tick > tick) {
+        return false;
+    }
+
+    std::pop_heap(queue.begin(), queue.end(), Later());
+    event = queue.back();
+    queue.pop_back();
+    return true;
+}
+
+void Scheduler::cancel(EventType type)
+{
+    queue.erase(std::remove_if(queue.begin(), queue.end(), [type](const Event &event) { return event.type == type; }), queue.end());
+    std::make_heap(queue.begin(), queue.end(), Later());
+}
+
+void Scheduler::saveState(SnapshotWriter &writer)
+{
+    writer.write(nextOrder);
+    writer.writeArray(queue);
+}
+
+bool Scheduler::loadState(SnapshotReader &reader)
+{
+    reader.read(nextOrder);
+    reader.readArray(queue);
+    if (reader.hasFailed()) {
+        return false;
+    }
+    std::make_heap(queue.begin(), queue.end(), Later()); // the saved order is already a heap, this only guards against a damaged file
+    return true;
+}
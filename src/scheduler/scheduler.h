@@ -0,0 +1,44 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "../save/snapshot.h"
+
+enum EventType
+{
+    EVENT_PRODUCTION, // the player gets the food and coral of their tiles
+    EVENT_WAVE, // the next wave spawns
+    EVENT_TRAINING_DONE, // target is the tile index of the training tile
+};
+
+struct Event
+{
+    int64_t tick;
+    int64_t order; // events of the same tick run in the order they were scheduled
+    int32_t type;
+    int32_t target;
+};
+
+// the timed work of a match on the simulation clock, a min heap on (tick, order)
+// scheduling and taking the next event is O(log n), nothing is polled while no event is due
+class Scheduler
+{
+private:
+    struct Later
+    {
+        bool operator()(const Event &a, const Event &b) const { return a.tick != b.tick ? a.tick > b.tick : a.order > b.order; } // std heap is a max heap
+    };
+    std::vector<Event> queue;
+    int64_t nextOrder;
+
+public:
+    void clear();
+    void schedule(int64_t tick, EventType type, int target = 0);
+    bool popDue(int64_t tick, Event &event); // false when the earliest event is after tick
+    void cancel(EventType type); // drops every event of that type, goes over the whole queue
+    int size() { return queue.size(); }
+    void saveState(SnapshotWriter &writer);
+    bool loadState(SnapshotReader &reader);
+
+    Scheduler();
+};
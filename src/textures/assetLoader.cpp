@@ -0,0 +1,150 @@
+#include <fstream>
+
+#include "assetLoader.h"
+
+AssetLoader::AssetLoader()
+{
+    nextJob = 0;
+    uploadedCount = 0;
+}
+
+AssetLoader::~AssetLoader()
+{
+    joinWorkers();
+    for (int i=0; i < jobs.size(); i++) {
+        if (jobs[i].isDecoded && !jobs[i].isUploaded) {
+            UnloadImage(jobs[i].image);
+        }
+    }
+}
+
+void AssetLoader::queue(std::string name, std::string fileName, bool generateMipmaps)
+{
+    Job job;
+    job.name = name;
+    job.fileName = fileName;
+    job.generateMipmaps = generateMipmaps;
+    job.needsDecode = !textureCache.contains(fileName);
+    job.sameFileAs = -1;
+    for (int i=0; i < jobs.size() && job.needsDecode; i++) {
+        if (jobs[i].fileName == fileName) {
+            job.needsDecode = false;
+            job.sameFileAs = i;
+        }
+    }
+    job.image = { 0 };
+    job.isDecoded = false;
+    job.isUploaded = false;
+    jobs.push_back(job);
+}
+
+bool AssetLoader::queueManifest(std::string manifestFile)
+{
+    std::ifstream manifest(manifestFile);
+    if (!manifest.is_open()) {
+        return false;
+    }
+
+    std::string name, fileName;
+    int queued = 0;
+    while (manifest >> name >> fileName) {
+        queue(name, fileName, true); // baked sprites are small, building the mip chain on load is cheaper than storing it
+        queued++;
+    }
+    return queued > 0;
+}
+
+void AssetLoader::start(int workerCount)
+{
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+    for (int i=0; i < workerCount; i++) {
+        workers.push_back(std::thread(&AssetLoader::decodeJobs, this));
+    }
+}
+
+void AssetLoader::decodeJobs()
+{
+    while (true) {
+        int i = nextJob++;
+        if (i >= jobs.size()) {
+            return;
+        }
+        if (!jobs[i].needsDecode) {
+            continue;
+        }
+
+        Image image = LoadImage(jobs[i].fileName.c_str());
+
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        jobs[i].image = image;
+        jobs[i].isDecoded = true;
+    }
+}
+
+void AssetLoader::joinWorkers()
+{
+    for (int i=0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    workers.clear();
+}
+
+bool AssetLoader::uploadSome(TextureRegistry *textures, double budgetSeconds)
+{
+    double startTime = GetTime();
+    for (int i=0; i < jobs.size(); i++) {
+        if (jobs[i].isUploaded) {
+            continue;
+        }
+
+        if (!jobs[i].needsDecode) {
+            if (jobs[i].sameFileAs != -1 && !jobs[jobs[i].sameFileAs].isUploaded) {
+                continue; // wait for the job that decodes the file
+            }
+            textures->load(jobs[i].name, jobs[i].fileName);
+            jobs[i].isUploaded = true;
+            uploadedCount++;
+            continue;
+        }
+
+        Image image;
+        {
+            std::lock_guard<std::mutex> lock(decodedMutex);
+            if (!jobs[i].isDecoded) {
+                continue;
+            }
+            image = jobs[i].image;
+        }
+
+        Texture2D texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        if (jobs[i].generateMipmaps) {
+            GenTextureMipmaps(&texture);
+            SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+        }
+        textureCache.insert(jobs[i].fileName, texture);
+        textures->load(jobs[i].name, jobs[i].fileName);
+        jobs[i].isUploaded = true;
+        uploadedCount++;
+
+        if (GetTime() - startTime > budgetSeconds) { // at least one upload per call, so loading always moves on
+            break;
+        }
+    }
+
+    if (isDone()) {
+        joinWorkers();
+        return true;
+    }
+    return false;
+}
+
+float AssetLoader::getProgress()
+{
+    if (jobs.empty()) {
+        return 1;
+    }
+    return (float)uploadedCount / jobs.size();
+}
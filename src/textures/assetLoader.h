@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "../raylib.h"
+
+#include "textureRegistry.h"
+
+// decodes queued sprites with LoadImage on worker threads, the gpu upload has to happen on the main thread
+// so uploadSome() is called once per frame with a time budget while a loading screen shows getProgress()
+// files that are already in the TextureCache (an earlier match) are not decoded again
+class AssetLoader
+{
+private:
+    struct Job
+    {
+        std::string name;
+        std::string fileName;
+        bool generateMipmaps;
+        bool needsDecode; // false when the file is already in the TextureCache or queued by an earlier job
+        int sameFileAs; // the earlier job with the same file, -1 for none
+        Image image;
+        bool isDecoded; // guarded by decodedMutex
+        bool isUploaded; // only touched by the main thread
+    };
+
+    std::vector<Job> jobs; // not resized after start()
+    std::vector<std::thread> workers;
+    std::atomic<int> nextJob;
+    std::mutex decodedMutex;
+    int uploadedCount;
+
+    void decodeJobs(); // worker thread body
+    void joinWorkers();
+public:
+    void queue(std::string name, std::string fileName, bool generateMipmaps = false);
+    bool queueManifest(std::string manifestFile); // "name file" per line as written by the bake tool, false when there is no manifest
+    void start(int workerCount);
+    bool uploadSome(TextureRegistry *textures, double budgetSeconds); // true once everything is in the registry
+    float getProgress();
+    bool isDone() { return uploadedCount == jobs.size(); }
+
+    AssetLoader();
+    ~AssetLoader();
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+// the source sprites of the registry, Game::Game loads these when there are no baked sprites
+// and the bake tool (src/tools/bakeAssets.cpp) downsamples them to bakeSize
+struct SpriteSource
+{
+    const char *name;
+    const char *file;
+    int bakeSize; // largest side after baking, a power of two just above the size the sprite is drawn at with the maximum zoom of 4
+};
+
+constexpr SpriteSource spriteSources[] = {
+    // tiles are drawn 115 high
+    { "locked",       "sprites/resources/BlankTile.png",       512 },
+    { "sea",          "sprites/resources/BlankTile.png",       512 },
+    { "food",         "sprites/resources/AlgenTile.png",       512 },
+    { "coral",        "sprites/resources/CoralTile.png",       512 },
+    { "training",     "sprites/buildings/TrainingTile.png",    512 },
+    { "castleV1",     "sprites/castle/CastleTileLVL1.png",     512 },
+    { "castleV2",     "sprites/castle/CastleTileLVL2.png",     512 },
+    { "castleV3",     "sprites/castle/CastleTileLVL3.png",     512 },
+    { "castleV4",     "sprites/castle/CastleTileLVL4.png",     512 },
+    { "castleV5",     "sprites/castle/CastleTileLVL5.png",     512 },
+
+    // units are drawn 81 wide
+    { "warrior1LVL1", "sprites/units/Battlefish.png",          512 },
+    { "warrior2LVL1", "sprites/units/BattlefishRed.png",       512 },
+    { "warrior1LVL2", "sprites/units/BattleHorse.png",         512 },
+    { "warrior2LVL2", "sprites/units/BattleHorseRed.png",      512 },
+    { "warrior1LVL3", "sprites/units/Angler.png",              512 },
+    { "warrior2LVL3", "sprites/units/AnglerRed.png",           512 },
+    { "warrior1LVL4", "sprites/units/BattleHorse.png",         512 },
+    { "warrior2LVL4", "sprites/units/BattleHorseRed.png",      512 },
+    { "warrior1LVL5", "sprites/units/SharkRegular.png",        512 },
+    { "warrior2LVL5", "sprites/units/SharkRed.png",            512 },
+};
+
+constexpr int spriteSourceCount = sizeof(spriteSources) / sizeof(spriteSources[0]);
+
+const char* const BAKED_SPRITE_MANIFEST = "sprites/baked/manifest.txt";
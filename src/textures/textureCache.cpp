@@ -0,0 +1,112 @@
+#include "textureCache.h"
+
+TextureCache textureCache;
+
+Texture2D TextureCache::acquire(std::string fileName)
+{
+    std::map<std::string, Entry>::iterator it = entries.find(fileName);
+    if (it == entries.end()) {
+        Entry entry;
+        entry.texture = LoadTexture(fileName.c_str());
+        entry.references = 0;
+        it = entries.insert({fileName, entry}).first;
+    }
+    it->second.references++;
+    return it->second.texture;
+}
+
+void TextureCache::release(std::string fileName)
+{
+    std::map<std::string, Entry>::iterator it = entries.find(fileName);
+    if (it != entries.end() && it->second.references > 0) {
+        it->second.references--;
+    }
+}
+
+void TextureCache::insert(std::string fileName, Texture2D texture)
+{
+    std::map<std::string, Entry>::iterator it = entries.find(fileName);
+    if (it != entries.end()) {
+        UnloadTexture(texture); // decoded twice, keep the one that may already be in use
+        return;
+    }
+
+    Entry entry;
+    entry.texture = texture;
+    entry.references = 0;
+    entries.insert({fileName, entry});
+}
+
+bool TextureCache::contains(std::string fileName)
+{
+    return entries.find(fileName) != entries.end();
+}
+
+int TextureCache::getReferences(std::string fileName)
+{
+    std::map<std::string, Entry>::iterator it = entries.find(fileName);
+    return it == entries.end() ? 0 : it->second.references;
+}
+
+void TextureCache::trim()
+{
+    std::map<std::string, Entry>::iterator it = entries.begin();
+    while (it != entries.end()) {
+        if (it->second.references == 0) {
+            UnloadTexture(it->second.texture);
+            it = entries.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void TextureCache::unloadAll()
+{
+    std::map<std::string, Entry>::iterator it;
+    for (it = entries.begin(); it != entries.end(); it++) {
+        UnloadTexture(it->second.texture);
+    }
+    entries.clear();
+}
+
+CachedTexture::CachedTexture(std::string setFileName)
+{
+    fileName = setFileName;
+    texture = { 0 };
+    if (!fileName.empty()) {
+        texture = textureCache.acquire(fileName);
+    }
+}
+
+CachedTexture::CachedTexture(const CachedTexture &other)
+{
+    fileName = other.fileName;
+    texture = other.texture;
+    if (!fileName.empty()) {
+        textureCache.acquire(fileName);
+    }
+}
+
+CachedTexture& CachedTexture::operator=(const CachedTexture &other)
+{
+    if (this == &other) {
+        return *this;
+    }
+    if (!other.fileName.empty()) {
+        textureCache.acquire(other.fileName); // before releasing, in case both are the same file
+    }
+    if (!fileName.empty()) {
+        textureCache.release(fileName);
+    }
+    fileName = other.fileName;
+    texture = other.texture;
+    return *this;
+}
+
+CachedTexture::~CachedTexture()
+{
+    if (!fileName.empty()) {
+        textureCache.release(fileName);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <map>
+#include <string>
+#include "../raylib.h"
+
+// every texture loaded from a file goes through here, so a file is only decoded and uploaded once per run
+// textures nobody references anymore stay on the gpu until trim(), that makes starting the next match from the menu cheap
+class TextureCache
+{
+private:
+    struct Entry
+    {
+        Texture2D texture;
+        int references;
+    };
+    std::map<std::string, Entry> entries;
+public:
+    Texture2D acquire(std::string fileName); // loads the file the first time
+    void release(std::string fileName);
+    void insert(std::string fileName, Texture2D texture); // for textures decoded somewhere else (AssetLoader), starts without references
+    bool contains(std::string fileName);
+    int getReferences(std::string fileName);
+    void trim(); // unloads the textures without references
+    void unloadAll();
+};
+
+extern TextureCache textureCache;
+
+// keeps a reference to a cached texture for as long as it lives, copies take their own reference
+// for value types like Menu and GameOver that are copied around
+class CachedTexture
+{
+private:
+    std::string fileName;
+    Texture2D texture;
+public:
+    Texture2D& get() { return texture; }
+
+    CachedTexture(std::string setFileName = "");
+    CachedTexture(const CachedTexture &other);
+    CachedTexture& operator=(const CachedTexture &other);
+    ~CachedTexture();
+};
@@ -0,0 +1,85 @@
+#include "textureRegistry.h"
+
+TextureRegistry::TextureRegistry()
+{
+    emptyTexture = { 0 };
+}
+
+TextureRegistry::~TextureRegistry()
+{
+}
+
+TextureHandle TextureRegistry::load(std::string name, std::string fileName)
+{
+    return set(name, textureCache.acquire(fileName), fileName);
+}
+
+TextureHandle TextureRegistry::add(std::string name, Texture2D texture)
+{
+    return set(name, texture, "");
+}
+
+TextureHandle TextureRegistry::set(std::string name, Texture2D texture, std::string fileName)
+{
+    TextureHandle handle = getHandle(name);
+    if (handle != NO_TEXTURE) {
+        releaseTexture(handle);
+        textures[handle] = texture; // same name again replaces the texture, handles stay valid
+        fileNames[handle] = fileName;
+        return handle;
+    }
+
+    handle = textures.size();
+    textures.push_back(texture);
+    fileNames.push_back(fileName);
+    names.push_back(name);
+    handles[name] = handle;
+    return handle;
+}
+
+void TextureRegistry::releaseTexture(TextureHandle handle)
+{
+    if (fileNames[handle].empty()) {
+        UnloadTexture(textures[handle]);
+    } else {
+        textureCache.release(fileNames[handle]);
+    }
+}
+
+TextureHandle TextureRegistry::getHandle(std::string name)
+{
+    std::map<std::string, TextureHandle>::iterator it = handles.find(name);
+    if (it == handles.end()) {
+        return NO_TEXTURE;
+    }
+    return it->second;
+}
+
+std::string TextureRegistry::getName(TextureHandle handle)
+{
+    if (handle < 0 || handle >= (int)names.size()) {
+        return "";
+    }
+    return names[handle];
+}
+
+Texture2D& TextureRegistry::get(std::string name)
+{
+    return get(getHandle(name));
+}
+
+int TextureRegistry::size()
+{
+    return textures.size();
+}
+
+void TextureRegistry::unloadAll()
+{
+    for (int i=0; i < textures.size(); i++) {
+        releaseTexture(i);
+    }
+    textures.clear();
+    fileNames.clear();
+    handles.clear();
+    names.clear(); // getName would still answer for the released handles
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "../raylib.h"
+
+#include "textureCache.h"
+
+// small index into the TextureRegistry, this is what tiles and units store instead of a texture or a texture map
+typedef int16_t TextureHandle;
+const TextureHandle NO_TEXTURE = -1;
+
+// owns every sprite texture of a match, the rest of the game refers to them with a TextureHandle
+class TextureRegistry
+{
+private:
+    std::vector<Texture2D> textures;
+    std::vector<std::string> fileNames; // file in the TextureCache, empty for textures the registry owns itself (the tile atlas)
+    std::map<std::string, TextureHandle> handles; // only used when loading and for ui code that works with names
+    std::vector<std::string> names; // the other way around, for snapshots
+    Texture2D emptyTexture;
+
+    TextureHandle set(std::string name, Texture2D texture, std::string fileName);
+    void releaseTexture(TextureHandle handle);
+public:
+    TextureHandle load(std::string name, std::string fileName); // shared through the TextureCache
+    TextureHandle add(std::string name, Texture2D texture); // the registry unloads it in unloadAll
+    TextureHandle getHandle(std::string name);
+    std::string getName(TextureHandle handle); // empty for NO_TEXTURE
+    Texture2D& get(TextureHandle handle) { return handle >= 0 && handle < (int)textures.size() ? textures[handle] : emptyTexture; }
+    Texture2D& get(std::string name);
+    int size();
+    void unloadAll(); // gives the cached textures back to the cache and unloads the rest
+
+    TextureRegistry();
+    ~TextureRegistry();
+};
@@ -0,0 +1,51 @@
+#include <cstdio>
+#include <string>
+#include "../raylib.h"
+
+#include "../textures/spriteList.h"
+
+// offline step (make bake), writes every registry sprite downsampled to its bakeSize and a manifest
+// that Game::Game loads instead of the 810px sources, mipmaps are generated when the game loads them
+int main(int argc, char *argv[])
+{
+    std::string outputDir = argc > 1 ? argv[1] : "sprites/baked";
+    std::string manifestFile = outputDir + "/manifest.txt";
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    FILE *manifest = fopen(manifestFile.c_str(), "w");
+    if (manifest == NULL) {
+        printf("can't write %s, does the directory exist?\n", manifestFile.c_str());
+        return 1;
+    }
+
+    int failed = 0;
+    for (int i=0; i < spriteSourceCount; i++) {
+        const SpriteSource &source = spriteSources[i];
+        Image image = LoadImage(source.file);
+        if (image.data == NULL) {
+            printf("can't load %s\n", source.file);
+            failed++;
+            continue;
+        }
+
+        // keep the aspect ratio, the largest side becomes bakeSize
+        int largestSide = image.width > image.height ? image.width : image.height;
+        if (largestSide > source.bakeSize) {
+            ImageResize(&image, image.width * source.bakeSize / largestSide, image.height * source.bakeSize / largestSide);
+        }
+
+        std::string bakedFile = outputDir + "/" + source.name + ".png";
+        if (!ExportImage(image, bakedFile.c_str())) {
+            printf("can't write %s\n", bakedFile.c_str());
+            failed++;
+        } else {
+            fprintf(manifest, "%s %s\n", source.name, bakedFile.c_str());
+            printf("%s -> %s (%dx%d)\n", source.file, bakedFile.c_str(), image.width, image.height);
+        }
+        UnloadImage(image);
+    }
+
+    fclose(manifest);
+    return failed > 0 ? 1 : 0;
+}
@@ -24,12 +24,11 @@ GameOver::GameOver(int screenWidth, int screenHeight)
             endY.push_back(val * (i + 1) - 50);
       }
 
-      backgroundImage = LoadTexture("sprites/UI-elements/SeafishTITLE.png");
+      backgroundImage = CachedTexture("sprites/UI-elements/SeafishTITLE.png"); // the menu and every game over screen share one texture
 }
 
 GameOver::~GameOver()
 {
-      // UnloadTexture(backgroundImage);
 }
 
 void GameOver::Draw(int screenWidth, int screenHeight, double time)
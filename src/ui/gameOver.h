@@ -2,6 +2,8 @@
 #include <vector>
 #include "../raylib.h"
 
+#include "../textures/textureCache.h"
+
 class GameOver
 {
 private:
@@ -22,7 +24,7 @@ private:
     std::vector<const char *> gameOverTexts;
     std::vector<float> startX, startY, endX, endY;
 
-    Texture2D backgroundImage;
+    CachedTexture backgroundImage;
 public:
     int buttonPressed;
     bool running;
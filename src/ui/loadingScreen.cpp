@@ -18,31 +18,26 @@ void loadingScreen(float fontSize, float screenWidth, float screenHeight) {
     EndDrawing();
 }
 
-void blinkingLoadingScreen(float fontSize, float screenWidth, float screenHeight, bool *door) {
+void progressLoadingScreen(float fontSize, float screenWidth, float screenHeight, float progress) {
     const char *oneLetter = "A";
     const char *text = "Loading";
 
     float lenghtOfOneLetter = MeasureText(oneLetter, fontSize);
-    
+
     float startX = (screenWidth / 2) - (MeasureText(text, fontSize) / 2);
     float startY = (screenHeight/2 + 50);
     float endX = ((screenWidth / 2) + (MeasureText(text, fontSize) / 2));
-    float endY = (screenHeight/2 - 50);
-    int i=1;
-    while (*door) {
-        i = i *-1;
-        if (i == 1) {
-            BeginDrawing();
-                ClearBackground(WHITE);
-                DrawText(text, (screenWidth / 2) - (MeasureText(text, fontSize) / 2), screenHeight/2 - 50, fontSize, RED);
-                DrawLine(startX - (lenghtOfOneLetter / 2), startY + (lenghtOfOneLetter / 10), endX + lenghtOfOneLetter, startY + (lenghtOfOneLetter / 10), RED);
-            EndDrawing();
-        } else {
-            BeginDrawing();
-                ClearBackground(WHITE);
-                DrawText(text, (screenWidth / 2) - (MeasureText(text, fontSize) / 2), screenHeight/2 - 50, fontSize, BLACK);
-                DrawLine(startX - (lenghtOfOneLetter / 2), startY + (lenghtOfOneLetter / 10), endX + lenghtOfOneLetter, startY + (lenghtOfOneLetter / 10), RED);
-            EndDrawing();
-        }
-    }
-}
\ No newline at end of file
+
+    // the line under the text fills up from left to right
+    float lineStart = startX - (lenghtOfOneLetter / 2);
+    float lineEnd = endX + lenghtOfOneLetter;
+    float filledEnd = lineStart + (lineEnd - lineStart) * progress;
+
+    BeginDrawing();
+        ClearBackground(WHITE);
+        DrawText(text, (screenWidth / 2) - (MeasureText(text, fontSize) / 2), screenHeight/2 - 50, fontSize, RED);
+        DrawRectangle(lineStart, startY, lineEnd - lineStart, lenghtOfOneLetter / 5, LIGHTGRAY);
+        DrawRectangle(lineStart, startY, filledEnd - lineStart, lenghtOfOneLetter / 5, RED);
+        DrawText(TextFormat("%d%%", int(progress * 100)), lineEnd + lenghtOfOneLetter / 2, startY - fontSize / 8, fontSize / 4, RED);
+    EndDrawing();
+}
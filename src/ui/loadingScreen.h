@@ -4,4 +4,4 @@
 #include "../raylib.h"
 
 void loadingScreen(float fontSize, float screenWidth, float screenHeight);
-void blinkingLoadingScreen(float fontSize, float screenWidth, float screenHeight, bool *door);
\ No newline at end of file
+void progressLoadingScreen(float fontSize, float screenWidth, float screenHeight, float progress); // progress from 0 to 1
\ No newline at end of file
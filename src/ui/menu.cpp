@@ -24,12 +24,11 @@ Menu::Menu(int screenWidth, int screenHeight)
             endY.push_back(val * (i + 1) - 50);
       }
 
-      backgroundImage = LoadTexture("sprites/UI-elements/SeafishTITLE.png");
+      backgroundImage = CachedTexture("sprites/UI-elements/SeafishTITLE.png"); // the menu and every game over screen share one texture
 }
 
 Menu::~Menu()
 {
-      // UnloadTexture(backgroundImage);
 }
 
 void Menu::Draw(int screenWidth, int screenHeight)
@@ -37,7 +36,7 @@ void Menu::Draw(int screenWidth, int screenHeight)
       BeginDrawing();
       // Texture2D test = LoadTexture("test.png");
       ClearBackground(WHITE);
-      // DrawTextureEx(backgroundImage, {0,0}, 0, 1, WHITE);
+      // DrawTextureEx(backgroundImage.get(), {0,0}, 0, 1, WHITE);
 
       for (int i = 0; i < menuTexts.size(); i++)
       {
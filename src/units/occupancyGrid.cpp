@@ -0,0 +1,128 @@
+#include <cstdlib>
+
+#include "occupancyGrid.h"
+#include "../map/map.h"
+
+OccupancyGrid::OccupancyGrid(int setRows, int setCols)
+{
+    resize(setRows, setCols);
+}
+
+void OccupancyGrid::resize(int setRows, int setCols)
+{
+    rows = setRows;
+    cols = setCols;
+    int words = (rows * cols + 63) / 64;
+
+    units.assign(rows * cols, NO_UNIT);
+    for (int owner=0; owner < OWNER_COUNT; owner++) {
+        ownerBits[owner].assign(words, 0);
+    }
+    blockedBits.assign(words, 0);
+}
+
+void OccupancyGrid::setBit(std::vector<uint64_t> &bits, int tile, bool value)
+{
+    uint64_t mask = (uint64_t)1 << (tile & 63);
+    bits[tile >> 6] = value ? (bits[tile >> 6] | mask) : (bits[tile >> 6] & ~mask);
+}
+
+void OccupancyGrid::place(int tile, UnitHandle unit, UnitOwner owner)
+{
+    units[tile] = unit;
+    for (int other=0; other < OWNER_COUNT; other++) {
+        setBit(ownerBits[other], tile, other == owner);
+    }
+}
+
+void OccupancyGrid::clear(int tile)
+{
+    units[tile] = NO_UNIT;
+    for (int owner=0; owner < OWNER_COUNT; owner++) {
+        setBit(ownerBits[owner], tile, false);
+    }
+}
+
+void OccupancyGrid::setBlocked(int tile, bool isBlocked)
+{
+    setBit(blockedBits, tile, isBlocked);
+}
+
+int OccupancyGrid::countAround(int x, int y, UnitOwner owner)
+{
+    int count = 0;
+    for (int direction=0; direction < 6; direction++) {
+        int neighbourX, neighbourY;
+        Map::getNeighbour(x, y, direction, neighbourX, neighbourY);
+        if (neighbourX >= 0 && neighbourX < rows && neighbourY >= 0 && neighbourY < cols) {
+            count += isOccupiedBy(neighbourX * cols + neighbourY, owner);
+        }
+    }
+    return count;
+}
+
+void OccupancyGrid::unitsInRange(int x, int y, int range, UnitOwner owner, std::vector<UnitHandle> &result)
+{
+    // the map is "even-q" (even columns sit half a tile lower), compare in axial coordinates
+    int centerR = y - (x + (x & 1)) / 2;
+    for (int otherX = std::max(x - range, 0); otherX <= std::min(x + range, rows - 1); otherX++) {
+        for (int otherY = std::max(y - range - 1, 0); otherY <= std::min(y + range + 1, cols - 1); otherY++) {
+            int tile = otherX * cols + otherY;
+            if (!isOccupiedBy(tile, owner)) {
+                continue;
+            }
+
+            int dq = otherX - x;
+            int dr = otherY - (otherX + (otherX & 1)) / 2 - centerR;
+            if ((std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2 <= range) {
+                result.push_back(units[tile]);
+            }
+        }
+    }
+}
+
+int OccupancyGrid::countOwned(UnitOwner owner)
+{
+    int count = 0;
+    for (int i=0; i < ownerBits[owner].size(); i++) {
+        count += __builtin_popcountll(ownerBits[owner][i]);
+    }
+    return count;
+}
+
+void OccupancyGrid::saveState(SnapshotWriter &writer)
+{
+    writer.write(rows);
+    writer.write(cols);
+    writer.writeArray(units);
+    for (int owner=0; owner < OWNER_COUNT; owner++) {
+        writer.writeArray(ownerBits[owner]);
+    }
+    writer.writeArray(blockedBits);
+}
+
+bool OccupancyGrid::loadState(SnapshotReader &reader)
+{
+    int savedRows, savedCols;
+    std::vector<UnitHandle> savedUnits;
+    std::vector<uint64_t> savedOwnerBits[OWNER_COUNT];
+    std::vector<uint64_t> savedBlockedBits;
+
+    reader.read(savedRows);
+    reader.read(savedCols);
+    reader.readArray(savedUnits);
+    for (int owner=0; owner < OWNER_COUNT; owner++) {
+        reader.readArray(savedOwnerBits[owner]);
+    }
+    reader.readArray(savedBlockedBits);
+    if (reader.hasFailed() || savedRows != rows || savedCols != cols || savedUnits.size() != units.size()) {
+        return false;
+    }
+
+    units.swap(savedUnits);
+    for (int owner=0; owner < OWNER_COUNT; owner++) {
+        ownerBits[owner].swap(savedOwnerBits[owner]);
+    }
+    blockedBits.swap(savedBlockedBits);
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "unitHandle.h"
+#include "../save/snapshot.h"
+
+// which unit stands on which tile, the only place that is stored
+// tiles are map tile indices (Map::tileIndex), besides the handle per tile there is a bitset per owner
+// so "is there an enemy/friend here" and counting over an area don't have to resolve handles
+class OccupancyGrid
+{
+private:
+    int rows, cols;
+    std::vector<UnitHandle> units;
+    std::vector<uint64_t> ownerBits[OWNER_COUNT];
+    std::vector<uint64_t> blockedBits; // two units are fighting over the tile, nobody else can enter it
+
+    static bool testBit(const std::vector<uint64_t> &bits, int tile) { return (bits[tile >> 6] >> (tile & 63)) & 1; }
+    static void setBit(std::vector<uint64_t> &bits, int tile, bool value);
+public:
+    void resize(int setRows, int setCols); // clears everything
+
+    void place(int tile, UnitHandle unit, UnitOwner owner);
+    void clear(int tile);
+    void setBlocked(int tile, bool isBlocked);
+
+    UnitHandle unitAt(int tile) { return units[tile]; }
+    bool isOccupied(int tile) { return units[tile] != NO_UNIT; }
+    bool isOccupiedBy(int tile, UnitOwner owner) { return testBit(ownerBits[owner], tile); }
+    bool isBlocked(int tile) { return testBit(blockedBits, tile); }
+
+    int countAround(int x, int y, UnitOwner owner); // the six neighbours of (x, y)
+    void unitsInRange(int x, int y, int range, UnitOwner owner, std::vector<UnitHandle> &result); // hex distance <= range, appends to result
+    int countOwned(UnitOwner owner);
+
+    void saveState(SnapshotWriter &writer);
+    bool loadState(SnapshotReader &reader); // false and unchanged when the snapshot has another size
+
+    OccupancyGrid(int setRows = 0, int setCols = 0);
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+// reference to a unit in the UnitWorld, stays safe to hold after the unit died (indexOf then returns -1 for it)
+struct UnitHandle
+{
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const UnitHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const UnitHandle &other) const { return !(*this == other); }
+};
+
+const UnitHandle NO_UNIT = { UINT32_MAX, 0 };
+
+enum UnitOwner : uint8_t
+{
+    OWNER_PLAYER,
+    OWNER_WAVE,
+    OWNER_COUNT
+};
@@ -3,31 +3,29 @@
 #include <string>
 #include <map>
 #include "../raylib.h"
+#include "../textures/textureRegistry.h"
 
 #include "../map/tile.h"
 #include "../map/map.h"
-#include "unit.h"
+#include "unitWorld.h"
 
+// the units of one owner, the units themselves live in the shared UnitWorld
 class UnitInventory
 {
 private:
-    bool isAlive(Unit *unit);
-    void removeDead();
-
     Map *tileMap;
-    Camera2D *camera;
+    UnitWorld *world;
 
-    std::map<std::string, Texture2D> unitTextures;
-    Texture2D *tileHighLite;
+    TextureRegistry *textures;
 public:
-    std::string owner;
-    std::vector<Unit> units;
+    UnitOwner owner;
 
-    void createUnit(Vector2 startingPos, Camera2D *test, int level, double statMultiplier);
-    void Update(double dt, bool overlay);
+    bool createUnit(Vector2 startingPos, int level, double statMultiplier); // false when the tile is already taken
+    int count();
+    void Update(double dt);
     void Update(double dt, Vector2 target);
-    void Render();
+    void Render(double alpha);
 
-    UnitInventory(std::string setOnwer = "player", Map *setMap = NULL, Camera2D *setCamera = NULL, Texture2D *setTileHighLite = NULL, std::map<std::string, Texture2D> setUnitTextures = {});
+    UnitInventory(UnitOwner setOwner = OWNER_PLAYER, Map *setMap = NULL, UnitWorld *setWorld = NULL, TextureRegistry *setTextures = NULL);
     ~UnitInventory();
-};
\ No newline at end of file
+};
@@ -0,0 +1,822 @@
+#include <cstdlib>
+#include <algorithm>
+
+#include "unitWorld.h"
+
+template <typename T>
+static void swapRemove(std::vector<T> &values, int i)
+{
+    values[i] = values.back();
+    values.pop_back();
+}
+
+UnitWorld::UnitWorld(Map *setTileMap, Camera2D *setCamera, TextureRegistry *setTextures, Texture2D *setTileHighLite, Pathfinder *setPathfinder, FlowField *setCastleField, JobSystem *setJobs, Random *setRandom)
+{
+    tileMap = setTileMap;
+    camera = setCamera;
+    textures = setTextures;
+    tileHighLite = setTileHighLite;
+    pathfinder = setPathfinder;
+    castleField = setCastleField;
+    jobs = setJobs;
+    random = setRandom;
+    if (tileMap != NULL) {
+        occupancy.resize(tileMap->rows, tileMap->cols);
+    }
+    selectedOptionsUnit = NO_UNIT;
+}
+
+UnitWorld::~UnitWorld()
+{
+    tileMap = NULL;
+    camera = NULL;
+    textures = NULL;
+    tileHighLite = NULL;
+    pathfinder = NULL;
+    castleField = NULL;
+    jobs = NULL;
+    random = NULL;
+}
+
+UnitHandle UnitWorld::create(UnitOwner unitOwner, UnitStats stats, Vector2 gridPos, TextureHandle unitTexture)
+{
+    // placing on a taken tile would push the unit that is there off the grid while it stays alive
+    if (!tileMap->isInside(gridPos.x, gridPos.y) || occupancy.isOccupied(tileMap->tileIndex(gridPos.x, gridPos.y))) {
+        return NO_UNIT;
+    }
+
+    uint32_t newSlot;
+    if (!freeSlots.empty()) {
+        newSlot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        newSlot = slotGenerations.size();
+        slotGenerations.push_back(0);
+        slotToIndex.push_back(-1);
+    }
+
+    int i = slot.size();
+    slotToIndex[newSlot] = i;
+
+    slot.push_back(newSlot);
+    owner.push_back(unitOwner);
+    flags.push_back(UNIT_ALIVE | UNIT_CAN_MOVE);
+    gridX.push_back(gridPos.x);
+    gridY.push_back(gridPos.y);
+    currentTile.push_back(tileMap->tileIndex(gridPos.x, gridPos.y));
+    newTile.push_back(-1);
+    health.push_back(stats.maxHealth);
+    maxHealth.push_back(stats.maxHealth);
+    defence.push_back(stats.defence);
+    attackDamage.push_back(stats.attackDamage);
+    movementSpeed.push_back(stats.movementSpeed);
+    movingProgress.push_back(0);
+    previousMovingProgress.push_back(0);
+    startPosition.push_back({0, 0});
+    texture.push_back(unitTexture);
+    pathStart.push_back(-1);
+    pathGoal.push_back(-1);
+    pathStep.push_back(0);
+
+    UnitHandle handle = { newSlot, slotGenerations[newSlot] };
+
+    occupancy.place(currentTile[i], handle, unitOwner);
+
+    return handle;
+}
+
+void UnitWorld::removeAt(int i)
+{
+    uint32_t oldSlot = slot[i];
+    slotGenerations[oldSlot]++;
+    slotToIndex[oldSlot] = -1;
+    freeSlots.push_back(oldSlot);
+
+    if (i != slot.size() - 1) {
+        slotToIndex[slot.back()] = i;
+    }
+
+    swapRemove(slot, i);
+    swapRemove(owner, i);
+    swapRemove(flags, i);
+    swapRemove(gridX, i);
+    swapRemove(gridY, i);
+    swapRemove(currentTile, i);
+    swapRemove(newTile, i);
+    swapRemove(health, i);
+    swapRemove(maxHealth, i);
+    swapRemove(defence, i);
+    swapRemove(attackDamage, i);
+    swapRemove(movementSpeed, i);
+    swapRemove(movingProgress, i);
+    swapRemove(previousMovingProgress, i);
+    swapRemove(startPosition, i);
+    swapRemove(texture, i);
+    swapRemove(pathStart, i);
+    swapRemove(pathGoal, i);
+    swapRemove(pathStep, i);
+}
+
+int UnitWorld::indexOf(UnitHandle handle)
+{
+    if (!isValid(handle)) {
+        return -1;
+    }
+    return slotToIndex[handle.index];
+}
+
+UnitHandle UnitWorld::handleAt(int i)
+{
+    UnitHandle handle = { slot[i], slotGenerations[slot[i]] };
+    return handle;
+}
+
+bool UnitWorld::isValid(UnitHandle handle)
+{
+    return handle.index < slotGenerations.size() && slotToIndex[handle.index] != -1 && slotGenerations[handle.index] == handle.generation;
+}
+
+int UnitWorld::size()
+{
+    return slot.size();
+}
+
+int UnitWorld::countOwned(UnitOwner unitOwner)
+{
+    int count = 0;
+    for (int i=0; i < owner.size(); i++) {
+        if (owner[i] == unitOwner) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void UnitWorld::clear()
+{
+    while (size() > 0) {
+        removeAt(size() - 1);
+    }
+    selectedOptions.clear();
+    selectedOptionsUnit = NO_UNIT;
+    if (tileMap != NULL) {
+        occupancy.resize(tileMap->rows, tileMap->cols);
+    }
+}
+
+void UnitWorld::removeDead()
+{
+    int i = 0;
+    while (i < size()) {
+        if (!isAlive(i)) {
+            removeOptions(i);
+            removeAt(i); // the last unit now sits at i, so check i again
+        } else {
+            i++;
+        }
+    }
+}
+
+Vector2 UnitWorld::tileDrawPosition(int x, int y)
+{
+    Vector2 tilePos = tileMap->getTile({(float)x, (float)y})->getPos();
+    return {tilePos.x + 0.35f * tileMap->tileWidth, tilePos.y + 0.1f * tileMap->tileHeight};
+}
+
+bool UnitWorld::isFriendlyOnTile(int i, int tile)
+{
+    return occupancy.isOccupiedBy(tile, (UnitOwner)owner[i]);
+}
+
+bool UnitWorld::canEnter(int i, int x, int y)
+{
+    bool isNeighbour = false;
+    for (int direction=0; direction < 6; direction++) {
+        int neighbourX, neighbourY;
+        Map::getNeighbour(gridX[i], gridY[i], direction, neighbourX, neighbourY);
+        if (neighbourX == x && neighbourY == y) {
+            isNeighbour = true;
+            break;
+        }
+    }
+
+    bool isBorder = (x < 1 || x > tileMap->rows - 2 || y < 1 || y > tileMap->cols - 2);
+    if (!isNeighbour || isBorder) {
+        return false;
+    }
+
+    int tile = tileMap->tileIndex(x, y);
+    return !isTileTypeLocked(tileMap->tileAtIndex(tile).getType()) && !isFriendlyOnTile(i, tile) && !occupancy.isBlocked(tile);
+}
+
+void UnitWorld::startMove(int i, int x, int y)
+{
+    setFlag(i, UNIT_SELECTED, false);
+    startPosition[i] = tileDrawPosition(gridX[i], gridY[i]);
+    gridX[i] = x;
+    gridY[i] = y;
+
+    occupancy.clear(currentTile[i]);
+
+    newTile[i] = tileMap->tileIndex(x, y);
+
+    int enemy = indexOf(occupancy.unitAt(newTile[i]));
+    if (enemy != -1) {
+        setFlag(i, UNIT_FIGHTING, true);
+        setFlag(enemy, UNIT_CAN_MOVE, false);
+        occupancy.setBlocked(newTile[i], true);
+    }
+
+    setFlag(i, UNIT_MOVING, true);
+}
+
+void UnitWorld::fight(int i, double dt)
+{
+    int target = newTile[i];
+    int enemy = indexOf(occupancy.unitAt(target));
+    if (enemy == -1) { // the enemy is already gone, just walk onto the tile
+        setFlag(i, UNIT_FIGHTING, false);
+        return;
+    }
+
+    double damage = attackDamage[i] - defence[enemy]; // calc damage with defence
+    if (damage < 0) {
+        damage = 0;
+    }
+    health[enemy] -= damage * dt;
+
+    damage = attackDamage[enemy] - defence[i];
+    if (damage < 0) {
+        damage = 0;
+    }
+    health[i] -= damage * dt;
+
+    if (health[enemy] <= 0) {
+        occupancy.clear(currentTile[i]);
+        occupancy.setBlocked(currentTile[i], false);
+        occupancy.place(target, handleAt(i), (UnitOwner)owner[i]);
+        currentTile[i] = newTile[i];
+
+        setFlag(enemy, UNIT_ALIVE, false);
+        setFlag(i, UNIT_MOVING, false);
+
+        occupancy.setBlocked(target, false);
+
+        setFlag(i, UNIT_FIGHTING, false);
+    }
+
+    if (health[i] <= 0) {
+        occupancy.clear(currentTile[i]);
+        occupancy.setBlocked(currentTile[i], false);
+
+        currentTile[i] = -1;
+        setFlag(i, UNIT_ALIVE, false);
+        setFlag(i, UNIT_MOVING, false);
+
+        if (occupancy.isOccupied(target)) {
+            occupancy.setBlocked(target, false);
+            int other = indexOf(occupancy.unitAt(target));
+            if (other != -1) {
+                setFlag(other, UNIT_CAN_MOVE, true);
+            }
+        }
+
+        setFlag(i, UNIT_FIGHTING, false);
+    }
+}
+
+void UnitWorld::setOptions(int i)
+{
+    selectedOptions.clear();
+    selectedOptionsUnit = handleAt(i);
+
+    for (int direction=0; direction < 6; direction++) {
+        int x, y;
+        Map::getNeighbour(gridX[i], gridY[i], direction, x, y);
+        if (canEnter(i, x, y)) {
+            selectedOptions.push_back({(float)x, (float)y});
+        }
+    }
+}
+
+void UnitWorld::removeOptions(int i)
+{
+    if (selectedOptionsUnit == handleAt(i)) {
+        selectedOptions.clear();
+        selectedOptionsUnit = NO_UNIT;
+    }
+}
+
+bool UnitWorld::tileInOptions(int i, int x, int y)
+{
+    if (selectedOptionsUnit != handleAt(i)) {
+        return false;
+    }
+    for (int j=0; j < selectedOptions.size(); j++) {
+        if (selectedOptions[j].x == x && selectedOptions[j].y == y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UnitWorld::claimTiles(UnitOwner unitOwner)
+{
+    for (int i=0; i < size(); i++) {
+        if (owner[i] != unitOwner || !isAlive(i)) {
+            continue;
+        }
+
+        if (!occupancy.isOccupied(currentTile[i])) { // moving clears the tile the unit is leaving every tick, it stays claimed until the unit arrives
+            occupancy.place(currentTile[i], handleAt(i), (UnitOwner)owner[i]);
+        }
+    }
+}
+
+void UnitWorld::advanceMovement(UnitOwner unitOwner, double dt)
+{
+    // no branches that depend on other units, so this loop can be vectorized and split over the workers
+    const uint8_t moving = UNIT_ALIVE | UNIT_MOVING | UNIT_CAN_MOVE;
+    std::function<void(int, int)> advance = [this, unitOwner, dt, moving](int begin, int end) {
+        for (int i=begin; i < end; i++) {
+            previousMovingProgress[i] = movingProgress[i];
+        }
+        for (int i=begin; i < end; i++) {
+            bool isAdvancing = owner[i] == unitOwner && (flags[i] & moving) == moving;
+            movingProgress[i] += isAdvancing ? movementSpeed[i] * dt : 0.0;
+        }
+    };
+
+    if (jobs != NULL) {
+        jobs->parallelFor(size(), 4096, advance);
+    } else {
+        advance(0, size());
+    }
+}
+
+void UnitWorld::resolveMovement(UnitOwner unitOwner, double dt, bool lockEnemy)
+{
+    const uint8_t moving = UNIT_ALIVE | UNIT_MOVING | UNIT_CAN_MOVE;
+    for (int i=0; i < size(); i++) {
+        if (owner[i] != unitOwner || (flags[i] & moving) != moving) {
+            continue;
+        }
+
+        int target = newTile[i];
+        if (hasFlag(i, UNIT_FIGHTING)) {
+            occupancy.setBlocked(target, true);
+            if (lockEnemy) {
+                int enemy = indexOf(occupancy.unitAt(target));
+                if (enemy != -1) {
+                    setFlag(enemy, UNIT_CAN_MOVE, false);
+                }
+            }
+            fight(i, dt);
+        } else {
+            occupancy.place(target, handleAt(i), (UnitOwner)owner[i]);
+            occupancy.clear(currentTile[i]);
+            occupancy.setBlocked(target, false);
+        }
+
+        if (isAlive(i) && movingProgress[i] >= 100 && !hasFlag(i, UNIT_FIGHTING)) {
+            currentTile[i] = newTile[i];
+            newTile[i] = -1;
+            setFlag(i, UNIT_MOVING, false);
+            movingProgress[i] = 0;
+        }
+    }
+}
+
+bool UnitWorld::nextPathStep(int i, int &next)
+{
+    next = -1;
+    if (pathfinder == NULL || pathGoal[i] == -1) {
+        return true;
+    }
+
+    int here = tileMap->tileIndex(gridX[i], gridY[i]);
+    const std::vector<int> *path = pathfinder->getCachedPath(pathStart[i], pathGoal[i]);
+    if (path == NULL || pathStep[i] >= path->size() || (*path)[pathStep[i]] != here) {
+        // no path yet, the map changed or the unit got pushed off its path
+        if (pathfinder->getCachedPath(here, pathGoal[i]) == NULL && !pathfinder->hasBudget()) {
+            return false;
+        }
+        path = pathfinder->findPath(here, pathGoal[i]);
+        pathStart[i] = here;
+        pathStep[i] = 0;
+        if (path == NULL) {
+            return true;
+        }
+    }
+
+    if (pathStep[i] + 1 < path->size()) {
+        next = (*path)[pathStep[i] + 1];
+    }
+    return true;
+}
+
+void UnitWorld::greedyStep(int i, Vector2 target, int &stepX, int &stepY)
+{
+    // step roughly in the direction of the target
+    int x = gridX[i];
+    int y = gridY[i];
+    int optionX[3], optionY[3];
+    int optionCount = 0;
+
+    if (target.x > x && target.y > y) {
+        optionX[optionCount] = x + 1; optionY[optionCount++] = y + 1;
+    } else if (target.x > x && target.y < y) {
+        optionX[optionCount] = x + 1; optionY[optionCount++] = y - 1;
+    } else if (target.x < x && target.y > y) {
+        optionX[optionCount] = x - 1; optionY[optionCount++] = y + 1;
+    } else if (target.x < x && target.y < y) {
+        optionX[optionCount] = x - 1; optionY[optionCount++] = y - 1;
+    }
+
+    if (target.x > x) {
+        optionX[optionCount] = x + 1; optionY[optionCount++] = y;
+    } else if (target.x < x) {
+        optionX[optionCount] = x - 1; optionY[optionCount++] = y;
+    }
+
+    if (target.y > y) {
+        optionX[optionCount] = x; optionY[optionCount++] = y + 1;
+    } else if (target.y < y) {
+        optionX[optionCount] = x; optionY[optionCount++] = y - 1;
+    }
+
+    stepX = target.x;
+    stepY = target.y;
+    if (optionCount > 0) {
+        int choice = random->nextInt(optionCount);
+        stepX = optionX[choice];
+        stepY = optionY[choice];
+    }
+}
+
+int UnitWorld::fieldStep(int i, bool &isWaiting)
+{
+    isWaiting = false;
+    int here = tileMap->tileIndex(gridX[i], gridY[i]);
+    int bestTile = -1;
+    int bestDistance = castleField->getDistance(here);
+
+    for (int direction=0; direction < 6; direction++) {
+        int x, y;
+        Map::getNeighbour(gridX[i], gridY[i], direction, x, y);
+        if (!tileMap->isInside(x, y)) {
+            continue;
+        }
+
+        int neighbourDistance = castleField->getDistance(tileMap->tileIndex(x, y));
+        if (neighbourDistance == 0) { // standing next to the target
+            isWaiting = true;
+            return -1;
+        }
+        if (neighbourDistance < bestDistance) {
+            if (canEnter(i, x, y)) {
+                bestTile = tileMap->tileIndex(x, y);
+                bestDistance = neighbourDistance;
+            } else {
+                isWaiting = true; // a friend is on the way down, wait for it unless another way is free
+            }
+        }
+    }
+
+    if (bestTile != -1) {
+        isWaiting = false;
+    }
+    return bestTile;
+}
+
+// intent values besides a tile index
+static const int INTENT_STAY = -1;
+static const int INTENT_GREEDY = -2;
+
+void UnitWorld::decideWave(Vector2 target)
+{
+    if (castleField != NULL) {
+        castleField->update();
+    }
+    bool useField = castleField != NULL && castleField->getGoal() != -1;
+
+    // phase 1: every unit picks its step from the state at the start of the tick, nothing is written but intent[i]
+    // so the units can be split over the workers
+    intent.resize(size());
+    std::function<void(int, int)> decide = [this, useField](int begin, int end) {
+        for (int i=begin; i < end; i++) {
+            intent[i] = INTENT_STAY;
+            if (owner[i] != OWNER_WAVE || !isAlive(i) || !hasFlag(i, UNIT_CAN_MOVE) || hasFlag(i, UNIT_MOVING)) {
+                continue;
+            }
+
+            if (!useField) {
+                intent[i] = INTENT_GREEDY;
+                continue;
+            }
+
+            bool isWaiting;
+            int next = fieldStep(i, isWaiting);
+            if (next != -1) {
+                intent[i] = next;
+            } else if (!isWaiting) {
+                intent[i] = INTENT_GREEDY; // the target can't be reached over the field
+            }
+        }
+    };
+
+    if (jobs != NULL) {
+        jobs->parallelFor(size(), 512, decide);
+    } else {
+        decide(0, size());
+    }
+
+    // phase 2: apply the steps in index order, a unit that lost its tile to an earlier one this tick waits
+    // the same order on any number of threads, and the greedy step only draws its random numbers here
+    for (int i=0; i < size(); i++) {
+        int stepX, stepY;
+        if (intent[i] >= 0) {
+            stepX = intent[i] / tileMap->cols;
+            stepY = intent[i] % tileMap->cols;
+        } else if (intent[i] == INTENT_GREEDY) {
+            greedyStep(i, target, stepX, stepY);
+        } else {
+            continue;
+        }
+
+        if (canEnter(i, stepX, stepY)) {
+            startMove(i, stepX, stepY);
+        }
+    }
+}
+
+void UnitWorld::followPlayerPaths()
+{
+    for (int i=0; i < size(); i++) {
+        if (owner[i] != OWNER_PLAYER || pathGoal[i] == -1 || !isAlive(i) || !hasFlag(i, UNIT_CAN_MOVE) || hasFlag(i, UNIT_MOVING)) {
+            continue;
+        }
+
+        int next;
+        if (!nextPathStep(i, next)) {
+            continue; // try again next tick
+        }
+        if (next == -1) { // arrived or the tile can't be reached
+            pathGoal[i] = -1;
+            continue;
+        }
+
+        int stepX = next / tileMap->cols;
+        int stepY = next % tileMap->cols;
+        if (canEnter(i, stepX, stepY)) {
+            startMove(i, stepX, stepY);
+            movingProgress[i] = 0;
+            pathStep[i]++;
+        } else if (next == pathGoal[i] || isTileTypeLocked(tileMap->tileAtIndex(next).getType())) {
+            pathGoal[i] = -1; // the goal itself is taken or the way got built over
+        }
+    }
+}
+
+void UnitWorld::orderAt(int x, int y)
+{
+    for (int i=0; i < size(); i++) {
+        if (owner[i] != OWNER_PLAYER || !isAlive(i) || !hasFlag(i, UNIT_CAN_MOVE) || hasFlag(i, UNIT_MOVING)) {
+            continue;
+        }
+
+        bool isOwnTile = (x == gridX[i] && y == gridY[i]);
+        if (hasFlag(i, UNIT_SELECTED)) {
+            if (isOwnTile) {
+                setFlag(i, UNIT_SELECTED, false);
+                removeOptions(i);
+            } else if (tileInOptions(i, x, y)) {
+                startMove(i, x, y);
+                movingProgress[i] = 0;
+                removeOptions(i);
+            } else {
+                if (tileMap->isInside(x, y) && !isTileTypeLocked(tileMap->tileAt(x, y).getType())) {
+                    pathGoal[i] = tileMap->tileIndex(x, y); // further away, walk there along a path
+                    pathStart[i] = -1;
+                }
+                removeOptions(i);
+                setFlag(i, UNIT_SELECTED, false);
+            }
+        } else if (isOwnTile) {
+            pathGoal[i] = -1;
+            setFlag(i, UNIT_SELECTED, true);
+            setOptions(i);
+        }
+    }
+}
+
+void UnitWorld::updateWave(double dt, Vector2 target)
+{
+    removeDead();
+    claimTiles(OWNER_WAVE);
+    decideWave(target);
+    advanceMovement(OWNER_WAVE, dt);
+    resolveMovement(OWNER_WAVE, dt, true);
+}
+
+void UnitWorld::updatePlayer(double dt)
+{
+    removeDead();
+    claimTiles(OWNER_PLAYER);
+    followPlayerPaths();
+    advanceMovement(OWNER_PLAYER, dt);
+    resolveMovement(OWNER_PLAYER, dt, false);
+}
+
+void UnitWorld::saveState(SnapshotWriter &writer)
+{
+    // handles only mean something in this registry, write the names that are used and an index per unit
+    std::vector<TextureHandle> usedTextures;
+    std::vector<uint16_t> textureIndex(size());
+    for (int i=0; i < size(); i++) {
+        std::vector<TextureHandle>::iterator found = std::find(usedTextures.begin(), usedTextures.end(), texture[i]);
+        textureIndex[i] = found - usedTextures.begin();
+        if (found == usedTextures.end()) {
+            usedTextures.push_back(texture[i]);
+        }
+    }
+    writer.write((uint32_t)usedTextures.size());
+    for (int i=0; i < usedTextures.size(); i++) {
+        std::string name = textures != NULL ? textures->getName(usedTextures[i]) : "";
+        writer.writeArray(std::vector<char>(name.begin(), name.end()));
+    }
+    writer.writeArray(textureIndex);
+
+    writer.writeArray(slot);
+    writer.writeArray(owner);
+    writer.writeArray(flags);
+    writer.writeArray(gridX);
+    writer.writeArray(gridY);
+    writer.writeArray(currentTile);
+    writer.writeArray(newTile);
+    writer.writeArray(health);
+    writer.writeArray(maxHealth);
+    writer.writeArray(defence);
+    writer.writeArray(attackDamage);
+    writer.writeArray(movementSpeed);
+    writer.writeArray(movingProgress);
+    writer.writeArray(previousMovingProgress);
+    writer.writeArray(startPosition);
+    writer.writeArray(pathStart);
+    writer.writeArray(pathGoal);
+    writer.writeArray(pathStep);
+
+    writer.writeArray(slotGenerations);
+    writer.writeArray(slotToIndex);
+    writer.writeArray(freeSlots);
+    writer.writeArray(selectedOptions);
+    writer.write(selectedOptionsUnit);
+
+    occupancy.saveState(writer);
+}
+
+bool UnitWorld::loadState(SnapshotReader &reader)
+{
+    clear();
+
+    uint32_t textureCount = 0;
+    reader.read(textureCount);
+    std::vector<TextureHandle> savedTextures;
+    for (int i=0; i < textureCount && !reader.hasFailed(); i++) {
+        std::vector<char> name;
+        reader.readArray(name);
+        savedTextures.push_back(textures != NULL ? textures->getHandle(std::string(name.begin(), name.end())) : NO_TEXTURE);
+    }
+    std::vector<uint16_t> textureIndex;
+    reader.readArray(textureIndex);
+
+    reader.readArray(slot);
+    reader.readArray(owner);
+    reader.readArray(flags);
+    reader.readArray(gridX);
+    reader.readArray(gridY);
+    reader.readArray(currentTile);
+    reader.readArray(newTile);
+    reader.readArray(health);
+    reader.readArray(maxHealth);
+    reader.readArray(defence);
+    reader.readArray(attackDamage);
+    reader.readArray(movementSpeed);
+    reader.readArray(movingProgress);
+    reader.readArray(previousMovingProgress);
+    reader.readArray(startPosition);
+    reader.readArray(pathStart);
+    reader.readArray(pathGoal);
+    reader.readArray(pathStep);
+
+    reader.readArray(slotGenerations);
+    reader.readArray(slotToIndex);
+    reader.readArray(freeSlots);
+    reader.readArray(selectedOptions);
+    reader.read(selectedOptionsUnit);
+
+    // every per unit array has to have one entry per unit, or the passes would read past the end
+    int count = slot.size();
+    bool isConsistent = !reader.hasFailed() && textureIndex.size() == count && owner.size() == count && flags.size() == count
+        && gridX.size() == count && gridY.size() == count && currentTile.size() == count && newTile.size() == count
+        && health.size() == count && maxHealth.size() == count && defence.size() == count && attackDamage.size() == count
+        && movementSpeed.size() == count && movingProgress.size() == count && previousMovingProgress.size() == count
+        && startPosition.size() == count && pathStart.size() == count && pathGoal.size() == count && pathStep.size() == count
+        && slotToIndex.size() == slotGenerations.size() && occupancy.loadState(reader);
+    // and every index in them has to point inside the map and the slot tables, a damaged file must not get to the next tick
+    // (textureIndex is unsigned, so the upper bound is the only check it needs)
+    int tileCount = tileMap->tileCount();
+    // a living unit always has a tile and a moving one a tile it moves to, only dead units (removed next tick) have none
+    for (int i=0; i < count && isConsistent; i++) {
+        bool isUnitAlive = flags[i] & UNIT_ALIVE;
+        bool isUnitMoving = flags[i] & UNIT_MOVING;
+        isConsistent = textureIndex[i] < savedTextures.size() && slot[i] < slotToIndex.size() && slotToIndex[slot[i]] == i
+            && owner[i] < OWNER_COUNT && tileMap->isInside(gridX[i], gridY[i])
+            && currentTile[i] >= (isUnitAlive ? 0 : -1) && currentTile[i] < tileCount
+            && newTile[i] >= (isUnitAlive && isUnitMoving ? 0 : -1) && newTile[i] < tileCount
+            && pathStart[i] >= -1 && pathStart[i] < tileCount && pathGoal[i] >= -1 && pathGoal[i] < tileCount && pathStep[i] >= 0;
+    }
+    for (int i=0; i < slotToIndex.size() && isConsistent; i++) {
+        isConsistent = slotToIndex[i] >= -1 && slotToIndex[i] < count;
+    }
+    for (int i=0; i < freeSlots.size() && isConsistent; i++) {
+        isConsistent = freeSlots[i] < slotGenerations.size() && slotToIndex[freeSlots[i]] == -1;
+    }
+    for (int i=0; i < selectedOptions.size() && isConsistent; i++) {
+        isConsistent = tileMap->isInside(selectedOptions[i].x, selectedOptions[i].y);
+    }
+    // a unit on the grid is standing on that tile or moving into it, with its owner's bit set
+    // (the other way around doesn't hold, a moving unit has left its current tile and another unit can take it)
+    for (int tile=0; tile < tileCount && isConsistent; tile++) {
+        int i = occupancy.isOccupied(tile) ? indexOf(occupancy.unitAt(tile)) : -1;
+        if (i != -1) {
+            isConsistent = (currentTile[i] == tile || newTile[i] == tile) && occupancy.isOccupiedBy(tile, (UnitOwner)owner[i]);
+        }
+    }
+    if (!isConsistent) {
+        *this = UnitWorld(tileMap, camera, textures, tileHighLite, pathfinder, castleField, jobs, random); // empty again
+        return false;
+    }
+
+    texture.resize(count);
+    for (int i=0; i < count; i++) {
+        texture[i] = savedTextures[textureIndex[i]];
+    }
+    return true;
+}
+
+void UnitWorld::drawStats(int i, Vector2 pos)
+{
+    Tile *tile = tileMap->getTile({0,0});
+    DrawText(TextFormat("HP: %d", int(health[i])), pos.x + 0.1 * tile->width, pos.y + 0.75 * tile->height, 10, WHITE);
+    if (hasFlag(i, UNIT_FIGHTING)) {
+        DrawText("fighting", pos.x + 0.1 * tile->width, pos.y + 0.8 * tile->height, 10, WHITE);
+    } else if (hasFlag(i, UNIT_MOVING)) {
+        DrawText("moving", pos.x + 0.1 * tile->width, pos.y + 0.8 * tile->height, 10, WHITE);
+    }
+}
+
+void UnitWorld::render(UnitOwner unitOwner, double alpha)
+{
+    int selected = indexOf(selectedOptionsUnit);
+    if (selected != -1 && owner[selected] == unitOwner) {
+        for (int j=0; j < selectedOptions.size(); j++) {
+            Tile *tile = tileMap->getTile(selectedOptions[j]);
+            DrawTextureEx(*tileHighLite, tile->getPos(), 0, (double) tileMap->tileHeight / 810, WHITE);
+        }
+    }
+
+    int minX, minY, maxX, maxY;
+    tileMap->getVisibleRange(*camera, minX, minY, maxX, maxY);
+
+    for (int i=0; i < size(); i++) {
+        if (owner[i] != unitOwner) {
+            continue;
+        }
+        if (gridX[i] < minX || gridX[i] > maxX || gridY[i] < minY || gridY[i] > maxY) {
+            continue; // off screen, a unit moving onto the screen is caught by the padding of the range
+        }
+
+        Vector2 drawPosition = tileDrawPosition(gridX[i], gridY[i]);
+
+        if (hasFlag(i, UNIT_MOVING)) {
+            // alpha is how far the frame is between the last tick and the next one
+            double progress = previousMovingProgress[i] + (movingProgress[i] - previousMovingProgress[i]) * alpha;
+            double t = progress / 100;
+            if (hasFlag(i, UNIT_FIGHTING) && t > 0.5) {
+                t = 0.5; // fighting units meet halfway between the tiles
+            } else if (t > 1) {
+                t = 1;
+            }
+
+            drawPosition = {
+                (float)(startPosition[i].x + (drawPosition.x - startPosition[i].x) * t),
+                (float)(startPosition[i].y + (drawPosition.y - startPosition[i].y) * t)
+            };
+        }
+
+        Texture2D &sprite = textures->get(texture[i]);
+        DrawTextureEx(sprite, drawPosition, 0, 81.0 / sprite.width, WHITE); // 81 wide, a tenth of the 810px sources
+        drawStats(i, drawPosition);
+    }
+}
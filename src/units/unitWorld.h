@@ -0,0 +1,120 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "../raylib.h"
+
+#include "../map/tile.h"
+#include "../map/map.h"
+#include "../textures/textureRegistry.h"
+#include "../pathfinding/pathfinder.h"
+#include "../pathfinding/flowField.h"
+#include "../jobs/jobSystem.h"
+#include "../random/random.h"
+#include "../save/snapshot.h"
+#include "unitHandle.h"
+#include "occupancyGrid.h"
+
+enum UnitFlag : uint8_t
+{
+    UNIT_ALIVE = 1,
+    UNIT_MOVING = 2,
+    UNIT_CAN_MOVE = 4,
+    UNIT_FIGHTING = 8,
+    UNIT_SELECTED = 16
+};
+
+struct UnitStats
+{
+    double maxHealth;
+    double defence;
+    double movementSpeed;
+    double attackDamage;
+};
+
+// every unit of a match (player and wave) stored as a structure of arrays
+// index i in each array is the same unit, the arrays are dense: removing a unit moves the last one into its place
+// so code outside of the world keeps a UnitHandle and asks indexOf() for the current index
+class UnitWorld
+{
+private:
+    Map *tileMap;
+    Camera2D *camera;
+    TextureRegistry *textures;
+    Texture2D *tileHighLite;
+    Pathfinder *pathfinder;
+    FlowField *castleField; // wave units walk down this field to their target
+    JobSystem *jobs; // NULL runs every pass on the calling thread
+    Random *random; // for the greedy step, only used from the serial part of decideWave
+
+    // what each wave unit wants to do this tick, filled in parallel by decideWave and applied in index order
+    std::vector<int> intent;
+
+    // handle -> index bookkeeping
+    std::vector<uint32_t> slotGenerations;
+    std::vector<int> slotToIndex; // -1 when the slot is free
+    std::vector<uint32_t> freeSlots;
+
+    // the tiles the selected player unit can move to
+    std::vector<Vector2> selectedOptions;
+    UnitHandle selectedOptionsUnit;
+
+    void removeAt(int i);
+    bool hasFlag(int i, uint8_t flag) { return (flags[i] & flag) != 0; }
+    void setFlag(int i, uint8_t flag, bool value) { flags[i] = value ? (flags[i] | flag) : (flags[i] & ~flag); }
+
+    Vector2 tileDrawPosition(int x, int y);
+    bool isFriendlyOnTile(int i, int tile);
+    bool canEnter(int i, int x, int y);
+    void startMove(int i, int x, int y);
+    void fight(int i, double dt);
+    void setOptions(int i);
+    void removeOptions(int i);
+    bool tileInOptions(int i, int x, int y);
+    bool nextPathStep(int i, int &next); // false when the pathfinder has no budget left this tick
+    int fieldStep(int i, bool &isWaiting); // best neighbour down the castle field, -1 when there is none to enter
+    void greedyStep(int i, Vector2 target, int &stepX, int &stepY);
+
+    // the passes of an update, each one walks the arrays for the units of one owner
+    void claimTiles(UnitOwner unitOwner);
+    void advanceMovement(UnitOwner unitOwner, double dt);
+    void resolveMovement(UnitOwner unitOwner, double dt, bool lockEnemy);
+    void decideWave(Vector2 target);
+    void followPlayerPaths();
+
+    void drawStats(int i, Vector2 pos);
+public:
+    OccupancyGrid occupancy; // the tile -> unit lookups, kept up to date by the passes
+
+    std::vector<uint32_t> slot; // handle index of the unit at each index
+    std::vector<uint8_t> owner;
+    std::vector<uint8_t> flags;
+    std::vector<int> gridX, gridY;
+    std::vector<int> currentTile, newTile; // tile indices in the map, -1 for none
+    std::vector<double> health, maxHealth, defence, attackDamage, movementSpeed;
+    std::vector<double> movingProgress, previousMovingProgress;
+    std::vector<Vector2> startPosition; // where the unit is drawn at the start of a move
+    std::vector<TextureHandle> texture;
+    std::vector<int> pathStart, pathGoal, pathStep; // the cached path a player unit walks (start and goal tile), -1 goal for none
+
+    UnitHandle create(UnitOwner unitOwner, UnitStats stats, Vector2 gridPos, TextureHandle unitTexture); // NO_UNIT when the tile is taken or off the map
+    int indexOf(UnitHandle handle); // -1 when the unit is gone
+    UnitHandle handleAt(int i);
+    bool isValid(UnitHandle handle);
+    bool isAlive(int i) { return hasFlag(i, UNIT_ALIVE); }
+    int size();
+    int countOwned(UnitOwner unitOwner);
+    void clear();
+
+    void removeDead();
+    void updateWave(double dt, Vector2 target);
+    void updatePlayer(double dt);
+    void orderAt(int x, int y); // the player clicked tile x, y: select, deselect, step to or walk to it, after updatePlayer
+    void render(UnitOwner unitOwner, double alpha);
+
+    // every unit of both owners, the handle bookkeeping and the occupancy, textures are stored by name
+    void saveState(SnapshotWriter &writer);
+    bool loadState(SnapshotReader &reader); // false when the snapshot doesn't fit, the world is empty then
+
+    UnitWorld(Map *setTileMap = NULL, Camera2D *setCamera = NULL, TextureRegistry *setTextures = NULL, Texture2D *setTileHighLite = NULL, Pathfinder *setPathfinder = NULL, FlowField *setCastleField = NULL, JobSystem *setJobs = NULL, Random *setRandom = NULL);
+    ~UnitWorld();
+};
@@ -1,4 +1,5 @@
 #include "wave.h"
+#include "../profiler/profiler.h"
 
 std::vector<Vector2> Wave2::genStartingPositions(int unitAmount) {
     std::vector<Vector2> borders = map->getBorders();
@@ -7,7 +8,7 @@ std::vector<Vector2> Wave2::genStartingPositions(int unitAmount) {
     
     int times = 0;
     while (numbers.size() < unitAmount || times >= 100) {
-        int number = rand() % borders.size();
+        int number = random->nextInt(borders.size());
 
         numbers.push_back(number);
 
@@ -31,19 +32,20 @@ std::vector<Vector2> Wave2::genStartingPositions(int unitAmount) {
 }
 
 void Wave2::spawnWave() {
+    PROFILE_ZONE("Wave2::spawnWave");
     int unitAmountDifference = maxUnitAmount - minUnitAmount;
     int unitLevelDifference = maxUnitLevel-minUnitLevel;
 
     int unitAmount;
     if (unitLevelDifference > 0) {
-        unitAmount = rand() % unitAmountDifference;
+        unitAmount = random->nextInt(unitAmountDifference);
     } else {
         unitAmount = 0;
     }
 
     int unitLevel;
     if (unitLevelDifference > 0) {
-        unitLevel = rand() % unitLevelDifference;
+        unitLevel = random->nextInt(unitLevelDifference);
     } else {
         unitLevel = 0;
     }
@@ -58,7 +60,7 @@ void Wave2::spawnWave() {
     std::vector<Vector2> startingPositions = genStartingPositions(unitAmount);
 
     for (int i=0; i < startingPositions.size(); i++) {
-        units.createUnit(startingPositions.at(i), camera, unitLevel, statMultiplier);
+        units.createUnit(startingPositions.at(i), unitLevel, statMultiplier); // skipped when a unit of an earlier wave still stands there
     }
 }
 
@@ -100,44 +102,73 @@ void Wave2::calcWaveLevel() {
 
 void Wave2::Update(double dt) {
     // units.UpdateCPU(dt)
+    units.Update(dt, target);
+}
+
+void Wave2::nextWave(double time) {
+    nextWaveTime = time + waveCoolDown;
+    spawnWave();
+    waveCount++;
+    calcWaveLevel();
+}
 
-    timeUntilNextWave -= dt;
+void Wave2::saveState(SnapshotWriter &writer) {
+    writer.write(waveCount);
+    writer.write(nextWaveTime);
+    writer.write(waveCoolDown);
+    writer.write(statMultiplier);
+    writer.write(minUnitLevel);
+    writer.write(maxUnitLevel);
+    writer.write(minUnitAmount);
+    writer.write(maxUnitAmount);
+    writer.write(target);
+}
 
-    if (timeUntilNextWave <= 0) {
-        timeUntilNextWave = waveCoolDown;
-        spawnWave();
+bool Wave2::loadState(SnapshotReader &reader) {
+    reader.read(waveCount);
+    reader.read(nextWaveTime);
+    reader.read(waveCoolDown);
+    reader.read(statMultiplier);
+    reader.read(minUnitLevel);
+    reader.read(maxUnitLevel);
+    reader.read(minUnitAmount);
+    reader.read(maxUnitAmount);
+    reader.read(target);
+    return !reader.hasFailed();
+}
+
+void Wave2::skipTo(int wave) {
+    // every wave builds on the levels and cooldown of the one before it
+    while (waveCount < wave) {
         waveCount++;
         calcWaveLevel();
     }
-
-    units.Update(dt, target);
 }
 
-void Wave2::Render() {
-    units.Render();
+void Wave2::Render(double alpha) {
+    units.Render(alpha);
 }
 
 void Wave2::Start() {
-    srand (time(NULL)); // set random seed for rand int
-
-    target = {map->rows/2, map->cols/2};
+    target = map->getCastleCoord();
 
     calcWaveLevel();
 }
 
-Wave2::Wave2(Map *map_, Camera2D *camera_, Texture2D *tileHighLite_, std::map<std::string, Texture2D> unitTextures_)
+Wave2::Wave2(Map *map_, Camera2D *camera_, Texture2D *tileHighLite_, TextureRegistry *textures_, UnitWorld *world_, Random *random_)
 {
     owner = "Wave";
     map = map_;
     camera = camera_;
     tileHighLite = tileHighLite_;
-    unitTextures = unitTextures_;
+    textures = textures_;
+    random = random_;
     waveCount = 0;
     waveCoolDown = 60;
-    timeUntilNextWave = 60; // in seconds
+    nextWaveTime = 60; // in seconds
     statMultiplier = 1;
 
-    units = UnitInventory("wave", map_, camera_, tileHighLite_, unitTextures_);
+    units = UnitInventory(OWNER_WAVE, map_, world_, textures_);
 }
 
 
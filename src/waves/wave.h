@@ -8,7 +8,9 @@
 #include "../units/unitInventory.h"
 #include "../map/tile.h"
 #include "../map/map.h"
-#include "../units/unit.h"
+#include "../units/unitWorld.h"
+#include "../random/random.h"
+#include "../save/snapshot.h"
 
 class Wave2
 {
@@ -19,7 +21,8 @@ private:
     Map *map;
     Camera2D *camera;
     Texture2D *tileHighLite;
-    std::map<std::string, Texture2D> unitTextures;
+    TextureRegistry *textures;
+    Random *random; // owned by the game, seeded in Game::Start
     Vector2 target;
 
     int maxUnitLevel;
@@ -35,13 +38,17 @@ private:
     void calcWaveLevel();
 public:
     int waveCount;
-    double timeUntilNextWave;
+    double nextWaveTime; // game time, the game schedules an EVENT_WAVE for it
     double waveCoolDown;
     
     void Update(double dt);
-    void Render();
+    void nextWave(double time); // spawns a wave now and sets nextWaveTime
+    void Render(double alpha);
     void Start();
+    void saveState(SnapshotWriter &writer); // the counters, the wave units are saved with the UnitWorld
+    bool loadState(SnapshotReader &reader);
+    void skipTo(int wave); // levels, amounts and cooldown of a later wave, without spawning the ones in between
 
-    Wave2(Map *map_ = NULL, Camera2D *camera_ = NULL, Texture2D *tileHighLite_ = NULL, std::map<std::string, Texture2D> unitTextures_ = {});
+    Wave2(Map *map_ = NULL, Camera2D *camera_ = NULL, Texture2D *tileHighLite_ = NULL, TextureRegistry *textures_ = NULL, UnitWorld *world_ = NULL, Random *random_ = NULL);
     ~Wave2();
 };